@@ -15,6 +15,18 @@ QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic
 SOURCES += \
     src/main.cpp \
     src/redisclient.cpp \
+    src/redisasyncclient.cpp \
+    src/redispubsubclient.cpp \
+    src/keyspacewatcher.cpp \
+    src/hiredisarena.cpp \
+    src/marketstreamconsumer.cpp \
+    src/valuecodec.cpp \
+    src/cborreader.cpp \
+    src/marketjsonscanner.cpp \
+    src/lenientjson.cpp \
+    src/recorddecoder.cpp \
+    src/fieldconvert.cpp \
+    src/rediswritequeue.cpp \
     src/marketmodel.cpp \
     src/datapoller.cpp \
     src/portfoliomodel.cpp \
@@ -24,6 +36,21 @@ SOURCES += \
 
 HEADERS += \
     src/redisclient.h \
+    src/redisasyncclient.h \
+    src/redispubsubclient.h \
+    src/keyspacewatcher.h \
+    src/hiredisarena.h \
+    src/marketstreamconsumer.h \
+    src/valuecodec.h \
+    src/cborreader.h \
+    src/jsonscan.h \
+    src/marketjsonscanner.h \
+    src/lenientjson.h \
+    src/recorddecoder.h \
+    src/recordlistmodel.h \
+    src/fieldconvert.h \
+    src/hashring.h \
+    src/rediswritequeue.h \
     src/marketmodel.h \
     src/datapoller.h \
     src/portfoliomodel.h \
@@ -36,10 +63,31 @@ HEADERS += \
 # Ressourcen (QML)
 RESOURCES += qml.qrc
 
-# hiredis Einbindung – Pfade anpassen falls nicht systemweit installiert
-# Beispiel (Linux): QMAKE_INCDIR += /usr/include/hiredis
-# Beispiel (Windows vcpkg): setze INCLUDE / LIB Pfade außerhalb oder nutze vcpkg integrate install
-LIBS += -lhiredis
+# hiredis Einbindung wie in CMake: gebündeltes hiredis-1.3.0 direkt mitkompiliert (Header und Quellen aus demselben
+# Stand, keine System-Bibliothek), sonst Stub. Quellenliste = hiredis_sources aus hiredis-1.3.0/CMakeLists.txt
+# (dict.c wird von async.c inkludiert)
+HIREDIS_SRC_DIR = $$PWD/hiredis-1.3.0
+exists($$HIREDIS_SRC_DIR/hiredis.c) {
+    INCLUDEPATH += $$HIREDIS_SRC_DIR
+    DEFINES += HIREDIS_VENDORED
+    SOURCES += \
+        $$HIREDIS_SRC_DIR/alloc.c \
+        $$HIREDIS_SRC_DIR/async.c \
+        $$HIREDIS_SRC_DIR/hiredis.c \
+        $$HIREDIS_SRC_DIR/net.c \
+        $$HIREDIS_SRC_DIR/read.c \
+        $$HIREDIS_SRC_DIR/sds.c \
+        $$HIREDIS_SRC_DIR/sockcompat.c
+    # RedisQtAdapter (adapters/qt.h) enthält Q_OBJECT -> moc
+    HEADERS += $$HIREDIS_SRC_DIR/adapters/qt.h
+    win32 {
+        DEFINES += _CRT_SECURE_NO_WARNINGS WIN32_LEAN_AND_MEAN
+        LIBS += -lws2_32 -lcrypt32
+    }
+} else {
+    warning("Bundled hiredis not found - falling back to stub (no live Redis connectivity)")
+    DEFINES += REDIS_STUB
+}
 
 # Deployment Hinweis Windows:
 # windeployqt QtTradeFrontend.exe
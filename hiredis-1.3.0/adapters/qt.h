@@ -96,30 +96,43 @@ class RedisQtAdapter : public QObject {
         void addRead() {
             if (m_read) return;
             m_read = new QSocketNotifier(m_ctx->c.fd, QSocketNotifier::Read, 0);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            connect(m_read, &QSocketNotifier::activated, this, &RedisQtAdapter::read);
+#else
             connect(m_read, SIGNAL(activated(int)), this, SLOT(read()));
+#endif
         }
 
         void delRead() {
             if (!m_read) return;
-            delete m_read;
+            /* may run inside the notifier's own activated() signal */
+            m_read->setEnabled(false);
+            m_read->deleteLater();
             m_read = 0;
         }
 
         void addWrite() {
             if (m_write) return;
             m_write = new QSocketNotifier(m_ctx->c.fd, QSocketNotifier::Write, 0);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            connect(m_write, &QSocketNotifier::activated, this, &RedisQtAdapter::write);
+#else
             connect(m_write, SIGNAL(activated(int)), this, SLOT(write()));
+#endif
         }
 
         void delWrite() {
             if (!m_write) return;
-            delete m_write;
+            m_write->setEnabled(false);
+            m_write->deleteLater();
             m_write = 0;
         }
 
         void cleanup() {
             delRead();
             delWrite();
+            /* the context is about to be freed; allows reuse via setContext() */
+            m_ctx = 0;
         }
 
     private slots:
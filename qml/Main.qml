@@ -37,6 +37,15 @@ ApplicationWindow {
                 StatusBadge { status: statusModel && statusModel.workerRunning ? 1 : 0; label: statusModel && statusModel.workerRunning ? "Worker" : "Worker" }
                 StatusBadge { status: statusModel && statusModel.alpacaApiActive ? 1 : 0; label: statusModel && statusModel.alpacaApiActive ? "Alpaca" : "Alpaca" }
                 StatusBadge { status: statusModel && statusModel.grokApiActive ? 1 : 0; label: statusModel && statusModel.grokApiActive ? "Grok" : "Grok" }
+                // Nur mit --master-host: rot = Replica hängt hinterher oder ist nicht erreichbar, Reads laufen über den Remote Master
+                // (oder, wenn der Master auch weg ist, weiter über die veraltete Replica: "Replica stale")
+                StatusBadge {
+                    visible: statusModel && statusModel.replicationRouted
+                    status: statusModel && statusModel.readSource === "replica" && !statusModel.replicationStale ? 1 : 0
+                    label: statusModel ? (statusModel.readSource === "replica" ? (statusModel.replicationStale ? "Replica stale" : "Replica") : "Master")
+                                         + (statusModel.replicaLinkUp && statusModel.replicationLagSeconds >= 0
+                                            ? " lag " + statusModel.replicationLagSeconds + "s" : " link down") : ""
+                }
             }
             MyLabel { text: Qt.formatTime(new Date(), "HH:mm:ss"); color: Theme.text; font.family: "Consolas" }
             Timer { interval: 1000; running: true; repeat: true; onTriggered: topBar.forceLayout() }
@@ -1,4 +1,5 @@
 #include "basemodel.h"
+#include "lenientjson.h"
 #include <QJsonParseError>
 #include <QDebug>
 #include <QDateTime>
@@ -17,26 +18,16 @@ void BaseModel::updateFromJson(const QByteArray& jsonData) {
     
     executeSafely([&]() {
         QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson(jsonData, &parseError);
-        
+        // JSON oder Python-Dict (repr) in einem Durchgang, ohne Quote-Replace
+        QJsonDocument doc = LenientJson::parse(jsonData, &parseError);
         if (parseError.error != QJsonParseError::NoError) {
-            // Try Python dict format
-            QString dataStr = QString::fromUtf8(jsonData);
-            if (dataStr.startsWith("{'") || dataStr.startsWith("{\"")) {
-                QString jsonStr = dataStr;
-                jsonStr.replace("'", "\"");
-                doc = QJsonDocument::fromJson(jsonStr.toUtf8(), &parseError);
-            }
-            
-            if (parseError.error != QJsonParseError::NoError) {
-                QString errorMsg = QString("JSON parse error at offset %1: %2")
-                    .arg(parseError.offset)
-                    .arg(parseError.errorString());
-                setError(errorMsg);
-                guard.setFailed(true);
-                emit validationFailed(errorMsg);
-                return;
-            }
+            QString errorMsg = QString("JSON parse error at offset %1: %2")
+                .arg(parseError.offset)
+                .arg(parseError.errorString());
+            setError(errorMsg);
+            guard.setFailed(true);
+            emit validationFailed(errorMsg);
+            return;
         }
         
         if (!validateJsonData(doc)) {
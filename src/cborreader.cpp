@@ -0,0 +1,82 @@
+// Streaming CBOR Leser (siehe cborreader.h)
+#include "cborreader.h"
+#include "fieldconvert.h"
+#include <QLocale>
+#include <cmath>
+
+bool CborReader::isCbor(const QByteArray& bytes) {
+    if (bytes.isEmpty()) return false;
+    const uchar first = uchar(bytes.at(0));
+    if (first >= 0x80 && first <= 0xbf) return true;
+    return bytes.startsWith("\xd9\xd9\xf7");
+}
+
+CborReader::CborReader(const QByteArray& bytes) : m_r(bytes) {}
+
+QString CborReader::readString() {
+    skipTags();
+    if (m_r.isString()) {
+        // Strings können in Chunks kommen (indefinite length)
+        QString out;
+        auto chunk = m_r.readString();
+        while (chunk.status == QCborStreamReader::Ok) {
+            out += chunk.data;
+            chunk = m_r.readString();
+        }
+        return chunk.status == QCborStreamReader::Error ? QString() : out;
+    }
+    if (m_r.isInteger()) {
+        const QString out = QString::number(m_r.toInteger());
+        m_r.next();
+        return out;
+    }
+    if (m_r.isDouble() || m_r.isFloat() || m_r.isFloat16()) {
+        // wie RecordDecoding::scalarFromJson: ganze Zahlen exakt (Epoch-Sekunden/-ms), sonst kürzeste Rundtrip-Form
+        const double v = readDouble();
+        if (std::trunc(v) == v && std::fabs(v) < 1e15) return QString::number(qint64(v));
+        return QString::number(v, 'g', QLocale::FloatingPointShortest);
+    }
+    m_r.next();
+    return {};
+}
+
+double CborReader::readDouble() {
+    skipTags();
+    double v = 0.0;
+    if (m_r.isString()) return FieldConvert::toDouble(readString().toUtf8());
+    if (m_r.isInteger()) v = double(m_r.toInteger());
+    else if (m_r.isDouble()) v = m_r.toDouble();
+    else if (m_r.isFloat()) v = double(m_r.toFloat());
+    else if (m_r.isFloat16()) v = double(float(m_r.toFloat16()));
+    m_r.next();
+    return v;
+}
+
+CborReader::ScalarType CborReader::readScalar(double& number, bool& boolean, QString& text) {
+    skipTags();
+    if (m_r.isString()) {
+        text = readString();
+        return StringScalar;
+    }
+    if (m_r.isInteger() || m_r.isDouble() || m_r.isFloat() || m_r.isFloat16()) {
+        number = readDouble();
+        return NumberScalar;
+    }
+    if (m_r.isBool()) {
+        boolean = m_r.toBool();
+        m_r.next();
+        return BoolScalar;
+    }
+    const bool null = m_r.isNull() || m_r.isUndefined();
+    m_r.next();
+    return null ? NullScalar : OtherScalar;
+}
+
+bool CborReader::readBool() {
+    skipTags();
+    bool v = false;
+    if (m_r.isBool()) v = m_r.toBool();
+    else if (m_r.isInteger()) v = m_r.toInteger() != 0;
+    m_r.next();
+    return v;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <QByteArray>
+#include <QCborStreamReader>
+#include <QString>
+
+// Streaming CBOR Leser für die Model-Eingänge (updateFromJson akzeptiert JSON oder CBOR, siehe redis.txt schema_meta 1.2).
+// Liest direkt aus dem Buffer per QCborStreamReader, ohne QCborValue/QJsonDocument DOM.
+// Feld-Callbacks müssen den Wert immer konsumieren (read*() oder skip()).
+class CborReader {
+public:
+    // CBOR erkannt am ersten Byte: Array (0x80-0x9f), Map (0xa0-0xbf) oder Self-Describe Tag 55799 (d9 d9 f7).
+    // JSON beginnt nie mit diesen Bytes (ASCII bzw. UTF-8 Startbyte).
+    static bool isCbor(const QByteArray& bytes);
+
+    explicit CborReader(const QByteArray& bytes);
+
+    bool ok() const { return m_r.lastError() == QCborError::NoError; }
+    bool isArray() { skipTags(); return m_r.isArray(); }
+    bool isMap() { skipTags(); return m_r.isMap(); }
+
+    // Skalare: Zahlen als Text bzw. numerische Strings als Zahl werden toleriert (wie die JSON Pfade)
+    QString readString();
+    double readDouble();
+    qint64 readInteger() { return qint64(readDouble()); }
+    bool readBool();
+    void skip() { skipTags(); m_r.next(); }
+    // Skalar mit seinem CBOR Typ (für die RecordSchema Setter, siehe RecordDecoding::scalarFromCbor); Maps/Arrays
+    // werden übersprungen und als OtherScalar gemeldet
+    enum ScalarType { NullScalar, BoolScalar, NumberScalar, StringScalar, OtherScalar };
+    ScalarType readScalar(double& number, bool& boolean, QString& text);
+
+    // Map: onField(key) je Eintrag. false wenn kein Map oder bei Dekodierfehler
+    template<typename Field> bool readMap(Field&& onField) {
+        skipTags();
+        if (!m_r.isMap()) { m_r.next(); return false; }
+        if (!m_r.enterContainer()) return false;
+        while (ok() && m_r.hasNext()) {
+            const QString key = readString();
+            onField(key);
+        }
+        return ok() && m_r.leaveContainer();
+    }
+    // Array von Maps (Listen-Keys): onField(key) je Feld, onRecordEnd() nach jeder Map; andere Elemente werden übersprungen
+    template<typename Field, typename End> bool forEachRecord(Field&& onField, End&& onRecordEnd) {
+        skipTags();
+        if (!m_r.isArray() || !m_r.enterContainer()) return false;
+        while (ok() && m_r.hasNext()) {
+            if (readMap(onField)) onRecordEnd();
+        }
+        return ok() && m_r.leaveContainer();
+    }
+
+private:
+    QCborStreamReader m_r;
+    void skipTags() { while (m_r.isTag()) m_r.next(); }
+};
@@ -4,40 +4,243 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QtEndian>
+#include "cborreader.h"
+#include "lenientjson.h"
+#include "recorddecoder.h"
+#include <cstring>
+#include <limits>
+
+// Spaltenweise Kerzen (t als epoch Sekunden, alternativ Text wenn das JSON t als String liefert).
+// Zwei Eingangsformate: chart_data_<SYM> (JSON Array) und chart_bin_<SYM> (binär, siehe redis.txt Abschnitt 2b):
+//   Header 16 Byte LE: char[4] "CHRT" | uint16 version (1) | uint16 headerSize | uint32 count | uint32 reserved
+//   danach zusammenhängende LE Spalten: int64 t[count], double o[count], h, l, c, vol
+// Das Binärformat wird spaltenweise per memcpy übernommen, ohne Parsen einzelner Felder.
+// Dritter Weg: chart_zset:<SYM> (redis.txt Abschnitt 2c), inkrementell per mergeTail() statt Model-Reset.
 
 struct Candle {
-    double o; double h; double l; double c; QString t; // t = timestamp/string
+    qint64 t = 0; double o = 0; double h = 0; double l = 0; double c = 0; double vol = 0;
+};
+
+// Kurzfelder laut Schema 1.1, lange Namen aus schema_meta.compat.legacy_mapping als Alias
+template<> struct RecordSchema<Candle> {
+    static constexpr auto fields = std::make_tuple(&Candle::t, &Candle::o, &Candle::h, &Candle::l, &Candle::c, &Candle::vol);
+    static constexpr RecordKey keys[] = {
+        {"t", 0, false}, {"o", 1, false}, {"h", 2, false}, {"l", 3, false}, {"c", 4, false}, {"vol", 5, false},
+        {"timestamp", 0, true}, {"open", 1, true}, {"high", 2, true}, {"low", 3, true}, {"close", 4, true}, {"volume", 5, true},
+    };
+};
+
+// Unveränderlicher Spalten-Snapshot aus der Decode-Stufe; tText nur gefüllt wenn das JSON t als String liefert
+struct ChartColumns {
+    QVector<qint64> t;
+    QVector<double> o, h, l, c, vol;
+    QVector<QString> tText;
 };
 
 class ChartDataModel : public QAbstractListModel {
     Q_OBJECT
 public:
-    enum Roles { OpenRole=Qt::UserRole+1, HighRole, LowRole, CloseRole, TimeRole };
+    enum Roles { OpenRole=Qt::UserRole+1, HighRole, LowRole, CloseRole, TimeRole, VolumeRole };
     explicit ChartDataModel(QObject* parent=nullptr): QAbstractListModel(parent) {}
 
-    int rowCount(const QModelIndex& parent=QModelIndex()) const override { return parent.isValid()?0:m_data.size(); }
+    int rowCount(const QModelIndex& parent=QModelIndex()) const override { return parent.isValid()?0:m_t.size(); }
     QVariant data(const QModelIndex& idx, int role) const override {
-        if(!idx.isValid()||idx.row()<0||idx.row()>=m_data.size()) return {};
-        const auto &cd = m_data[idx.row()];
+        if(!idx.isValid()||idx.row()<0||idx.row()>=m_t.size()) return {};
+        const int r = idx.row();
         switch(role){
-            case OpenRole: return cd.o; case HighRole: return cd.h; case LowRole: return cd.l; case CloseRole: return cd.c; case TimeRole: return cd.t; default: return {};
+            case OpenRole: return m_o[r]; case HighRole: return m_h[r]; case LowRole: return m_l[r]; case CloseRole: return m_c[r];
+            case TimeRole: return m_tText.isEmpty() ? QVariant(m_t[r]) : QVariant(m_tText[r]);
+            case VolumeRole: return m_vol[r];
+            default: return {};
         }
     }
     QHash<int,QByteArray> roleNames() const override {
-        return { {OpenRole,"o"},{HighRole,"h"},{LowRole,"l"},{CloseRole,"c"},{TimeRole,"t"} };
+        return { {OpenRole,"o"},{HighRole,"h"},{LowRole,"l"},{CloseRole,"c"},{TimeRole,"t"},{VolumeRole,"vol"} };
     }
 
+    static bool isBinary(const QByteArray& bytes) { return bytes.size() >= kBinHeaderSize && bytes.startsWith("CHRT"); }
+
+    // Nimmt auch Binär-Payloads an (z.B. per Pub/Sub), erkannt am "CHRT" Magic
     Q_INVOKABLE void updateFromJson(const QByteArray& bytes) {
-        QJsonParseError err{}; auto doc = QJsonDocument::fromJson(bytes,&err); if(err.error!=QJsonParseError::NoError||!doc.isArray()) return;
-        auto arr = doc.array(); QVector<Candle> fresh; fresh.reserve(arr.size());
-        for (auto v: arr) { if(!v.isObject()) continue; auto o=v.toObject(); Candle cd{ o.value("o").toDouble(), o.value("h").toDouble(), o.value("l").toDouble(), o.value("c").toDouble(), o.value("t").toString() }; fresh.push_back(cd);}        
-        beginResetModel(); m_data = std::move(fresh); endResetModel(); emit changed();
+        ChartColumns cols;
+        if (decodeColumns(bytes, cols)) applyColumns(cols);
     }
 
-    const QVector<Candle>& candles() const { return m_data; }
+    // Decode-Stufe ohne Model-Zustand (thread-safe): Binär, CBOR oder JSON/Python-Literal -> Spalten
+    static bool decodeColumns(const QByteArray& bytes, ChartColumns& out) {
+        if (isBinary(bytes)) return decodeBinary(bytes, out);
+        if (CborReader::isCbor(bytes)) return decodeCbor(bytes, out);
+        // Normalfall (numerisches t): ein Durchgang direkt in Candle Records, sonst DOM (Text-t, Python-Literal)
+        QVector<Candle> candles;
+        if (RecordDecoder::decodeArray(bytes, candles)) { out = columnsFromCandles(candles); return true; }
+        QJsonParseError err{}; auto doc = LenientJson::parse(bytes, &err); if(err.error!=QJsonParseError::NoError||!doc.isArray()) return false;
+        auto arr = doc.array();
+        ChartColumns cols; bool textTime = false;
+        cols.t.reserve(arr.size()); cols.o.reserve(arr.size()); cols.h.reserve(arr.size()); cols.l.reserve(arr.size()); cols.c.reserve(arr.size()); cols.vol.reserve(arr.size());
+        for (auto v: arr) {
+            if(!v.isObject()) continue;
+            // Keys/Aliase wie im RecordDecoder; nur ein Text-t lehnt der Setter ab, das bleibt hier als Text erhalten
+            auto obj=v.toObject(); Candle cd;
+            RecordDecoder::decodeJsonObject(obj, cd);
+            const QJsonValue tv = RecordDecoding::jsonField<Candle>(obj, 0);
+            const qint64 secs = tv.isString() ? 0 : cd.t;
+            if (tv.isString() && !textTime) { textTime = true; cols.tText.reserve(arr.size()); for (qint64 prev : cols.t) cols.tText.push_back(QString::number(prev)); }
+            if (textTime) cols.tText.push_back(tv.isString() ? tv.toString() : QString::number(secs));
+            cols.t.push_back(secs); cols.o.push_back(cd.o); cols.h.push_back(cd.h);
+            cols.l.push_back(cd.l); cols.c.push_back(cd.c); cols.vol.push_back(cd.vol);
+        }
+        out = std::move(cols);
+        return true;
+    }
+
+    // CBOR Array von {t,o,h,l,c,vol} Maps (bzw. Aliase), Keys und Setter wie im RecordDecoder; ein String-t lehnt der
+    // Setter ab, das bleibt wie im JSON Pfad als Text erhalten
+    static bool decodeCbor(const QByteArray& bytes, ChartColumns& out) {
+        CborReader r(bytes);
+        ChartColumns cols; bool textTime = false;
+        Candle cd; QString text; bool hasText = false; RecordDecoding::CborRecordState state;
+        const bool ok = r.forEachRecord([&](const QString& key) {
+            const bool accepted = RecordDecoding::readCborField(r, key, cd, state);
+            if (state.field != 0) return;
+            hasText = !accepted;
+            if (hasText) { text = QString::fromUtf8(state.value.text, state.value.length); cd.t = 0; }
+        }, [&] {
+            if (hasText && !textTime) { textTime = true; for (qint64 prev : cols.t) cols.tText.push_back(QString::number(prev)); }
+            if (textTime) cols.tText.push_back(hasText ? text : QString::number(cd.t));
+            cols.t.push_back(cd.t); cols.o.push_back(cd.o); cols.h.push_back(cd.h); cols.l.push_back(cd.l); cols.c.push_back(cd.c); cols.vol.push_back(cd.vol);
+            cd = Candle(); hasText = false; state.canonicalSeen = 0;
+        });
+        if (!ok) return false;
+        out = std::move(cols);
+        return true;
+    }
+
+    // false bei fremdem Magic, unbekannter Version oder zu kurzem Buffer (out bleibt dann unverändert)
+    static bool decodeBinary(const QByteArray& bytes, ChartColumns& out) {
+        if (!isBinary(bytes)) return false;
+        const auto* p = reinterpret_cast<const uchar*>(bytes.constData());
+        const quint16 version = qFromLittleEndian<quint16>(p + 4);
+        const quint16 headerSize = qFromLittleEndian<quint16>(p + 6);
+        const quint32 count = qFromLittleEndian<quint32>(p + 8);
+        if (version != 1 || headerSize < kBinHeaderSize) return false;
+        if (bytes.size() < qsizetype(headerSize) + qsizetype(count) * kBinRowSize) return false;
+        const uchar* col = p + headerSize;
+        const qsizetype n = qsizetype(count);
+        ChartColumns cols;
+        cols.t.resize(n); cols.o.resize(n); cols.h.resize(n); cols.l.resize(n); cols.c.resize(n); cols.vol.resize(n);
+        col = loadColumn(col, cols.t); col = loadColumn(col, cols.o); col = loadColumn(col, cols.h);
+        col = loadColumn(col, cols.l); col = loadColumn(col, cols.c); loadColumn(col, cols.vol);
+        out = std::move(cols);
+        return true;
+    }
+
+    // false bei fremdem Magic, unbekannter Version oder zu kurzem Buffer (Model bleibt dann unverändert)
+    Q_INVOKABLE bool updateFromBinary(const QByteArray& bytes) {
+        ChartColumns cols;
+        if (!decodeBinary(bytes, cols)) return false;
+        applyColumns(cols);
+        return true;
+    }
+
+    // Apply-Stufe (GUI Thread): Voll-Abgleich per Reset; die QVector Spalten werden nur geteilt, nicht kopiert
+    void applyColumns(const ChartColumns& cols) {
+        beginResetModel();
+        m_t = cols.t; m_o = cols.o; m_h = cols.h; m_l = cols.l; m_c = cols.c; m_vol = cols.vol;
+        m_tText = cols.tText;
+        endResetModel(); emit changed();
+    }
+
+    // Einzelne Kerze als JSON oder CBOR Objekt {t,o,h,l,c,vol} (ZSET Member); fehlende Felder bleiben 0
+    static bool parseCandle(const QByteArray& bytes, Candle& out) {
+        if (CborReader::isCbor(bytes)) {
+            // gleiche Keys/Aliase wie JSON; Text-t lehnt der Setter ab und bleibt unverändert, der ZSET Score setzt t
+            CborReader r(bytes); RecordDecoding::CborRecordState state;
+            return r.readMap([&](const QString& key) { RecordDecoding::readCborField(r, key, out, state); });
+        }
+        if (RecordDecoder::decodeObject(bytes, out)) return true;
+        QJsonParseError err{}; auto doc = LenientJson::parse(bytes, &err);
+        if (err.error != QJsonParseError::NoError || !doc.isObject()) return false;
+        RecordDecoder::decodeJsonObject(doc.object(), out); // Text-t bleibt unverändert, der ZSET Score setzt t
+        return true;
+    }
+
+    static ChartColumns columnsFromCandles(const QVector<Candle>& candles) {
+        ChartColumns cols;
+        const qsizetype n = candles.size();
+        cols.t.resize(n); cols.o.resize(n); cols.h.resize(n); cols.l.resize(n); cols.c.resize(n); cols.vol.resize(n);
+        for (qsizetype i = 0; i < n; ++i) {
+            const Candle& cd = candles[i];
+            cols.t[i] = cd.t; cols.o[i] = cd.o; cols.h[i] = cd.h; cols.l[i] = cd.l; cols.c[i] = cd.c; cols.vol[i] = cd.vol;
+        }
+        return cols;
+    }
+
+    // Voll-Abgleich (Reset), Kerzen aufsteigend nach t
+    void setCandles(const QVector<Candle>& candles) { applyColumns(columnsFromCandles(candles)); }
+
+    // Delta (Kerzen mit t >= lastTime(), aufsteigend): t == lastTime() ersetzt die laufende Kerze (dataChanged),
+    // neuere werden angehängt (beginInsertRows). Ältere Zeitstempel werden ignoriert (kommen mit dem Voll-Abgleich).
+    // false wenn kein Merge möglich ist (Text-Zeitstempel aus JSON aktiv) -> Aufrufer macht einen Voll-Abgleich.
+    bool mergeTail(const QVector<Candle>& candles) {
+        if (!m_tText.isEmpty()) return false;
+        bool any = false;
+        qsizetype first = 0;
+        if (!candles.isEmpty() && !m_t.isEmpty() && candles.first().t == m_t.last()) {
+            const qsizetype r = m_t.size() - 1; const Candle& cd = candles.first();
+            if (m_o[r] != cd.o || m_h[r] != cd.h || m_l[r] != cd.l || m_c[r] != cd.c || m_vol[r] != cd.vol) {
+                m_o[r] = cd.o; m_h[r] = cd.h; m_l[r] = cd.l; m_c[r] = cd.c; m_vol[r] = cd.vol;
+                emit dataChanged(index(int(r)), index(int(r)), { OpenRole, HighRole, LowRole, CloseRole, VolumeRole });
+                any = true;
+            }
+            first = 1;
+        }
+        QVector<Candle> fresh;
+        qint64 last = m_t.isEmpty() ? std::numeric_limits<qint64>::min() : m_t.last();
+        for (qsizetype i = first; i < candles.size(); ++i) {
+            if (candles[i].t <= last) continue;
+            last = candles[i].t;
+            fresh.push_back(candles[i]);
+        }
+        if (!fresh.isEmpty()) {
+            const int start = int(m_t.size());
+            beginInsertRows(QModelIndex(), start, start + int(fresh.size()) - 1);
+            for (const Candle& cd : fresh) {
+                m_t.push_back(cd.t); m_o.push_back(cd.o); m_h.push_back(cd.h); m_l.push_back(cd.l); m_c.push_back(cd.c); m_vol.push_back(cd.vol);
+            }
+            endInsertRows();
+            any = true;
+        }
+        if (any) emit changed();
+        return true;
+    }
+    qint64 lastTime() const { return m_t.isEmpty() ? 0 : m_t.last(); }
+
+    const QVector<qint64>& times() const { return m_t; }
+    const QVector<double>& closes() const { return m_c; }
 
 signals:
     void changed();
 private:
-    QVector<Candle> m_data;
+    static constexpr qsizetype kBinHeaderSize = 16;
+    static constexpr qsizetype kBinRowSize = 6 * 8; // int64 t + 5 double
+
+    // Kopiert eine LE Spalte (8 Byte Elemente) und liefert den Anfang der nächsten
+    template<typename T> static const uchar* loadColumn(const uchar* src, QVector<T>& dst) {
+        static_assert(sizeof(T) == 8, "chart_bin Spalten sind 8 Byte breit");
+        const qsizetype bytes = dst.size() * qsizetype(sizeof(T));
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        if (bytes) std::memcpy(dst.data(), src, size_t(bytes));
+#else
+        for (qsizetype i = 0; i < dst.size(); ++i) {
+            const quint64 raw = qFromLittleEndian<quint64>(src + i * 8);
+            std::memcpy(&dst[i], &raw, 8);
+        }
+#endif
+        return src + bytes;
+    }
+
+    QVector<qint64> m_t;
+    QVector<double> m_o, m_h, m_l, m_c, m_vol;
+    QVector<QString> m_tText; // nur gefüllt wenn das JSON t als String liefert
 };
@@ -1,9 +1,30 @@
 #include "datapoller.h"
+#include "hiredisarena.h"
+#include "valuecodec.h"
 #include <QByteArray>
 #include <QDateTime>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QStringList>
+#include <algorithm>
+#include <cstdlib>
+#include <future>
 #include <iostream>
+#include <thread>
+
+namespace {
+// Keys mit Symbol-Suffix (chart_data_AAPL, ...): Länge des Präfix, 0 = kein symbolbezogener Key
+size_t symbolPrefixLength(const std::string& key) {
+    for (const char* prefix : { "chart_data_", "chart_bin_", "predictions_" }) {
+        const size_t n = std::char_traits<char>::length(prefix);
+        if (key.compare(0, n, prefix) == 0) return n;
+    }
+    return 0;
+}
+
+// Obergrenze für das Warten auf Shard-Jobs nach dem Haupt-Fetch (mindestens der Client-Timeout)
+constexpr int kShardWaitMs = 2000;
+} // namespace
 
 DataPoller::DataPoller(MarketModel* market, const QString& host, int port, const QString& password,
                        PortfolioModel* portfolio, OrdersModel* orders, StatusModel* status, NotificationsModel* notifications,
@@ -16,80 +37,689 @@ DataPoller::DataPoller(MarketModel* market, const QString& host, int port, const
     connect(&m_timer, &QTimer::timeout, this, &DataPoller::poll);
 }
 
+DataPoller::~DataPoller() {
+    setDecodeThread(false);
+}
+
+void DataPoller::setDecodeThread(bool enabled) {
+    if (enabled == (m_decodeThread != nullptr)) return;
+    if (!enabled) {
+        // Laufender Auftrag wird noch fertig, bereits eingereihte verfallen mit dem Thread
+        m_decodeThread->quit();
+        m_decodeThread->wait();
+        m_decodeContext.reset();
+        m_decodeThread.reset();
+        pollSettled();
+        return;
+    }
+    m_decodeThread = std::make_unique<QThread>();
+    m_decodeThread->setObjectName("redis-decode");
+    m_decodeContext = std::make_unique<QObject>();
+    m_decodeContext->moveToThread(m_decodeThread.get());
+    m_decodeThread->start();
+}
+
+void DataPoller::setAsyncMode(bool enabled) {
+    if (enabled == (m_asyncClient != nullptr)) return;
+    if (!enabled) { m_asyncClient.reset(); pollSettled(); return; }
+    m_asyncClient = std::make_unique<RedisAsyncClient>(m_host.toStdString(), m_port, 0, m_password.toStdString());
+    // Nach (Re)Connect sofort pollen statt auf den nächsten Timer-Tick zu warten
+    connect(m_asyncClient.get(), &RedisAsyncClient::connected, this, &DataPoller::poll);
+    connect(m_asyncClient.get(), &RedisAsyncClient::disconnected, this, [this]() { setConnected(false); });
+    connect(m_asyncClient.get(), &RedisAsyncClient::errorOccurred, this, [this](const QString& msg) {
+        if (m_perfLogging) qWarning() << "async redis:" << msg;
+    });
+}
+
+void DataPoller::setPubSubClient(RedisPubSubClient* client) {
+    if (m_pubSub) { disconnect(m_pubSub, nullptr, this, nullptr); disconnect(this, nullptr, m_pubSub, nullptr); }
+    m_pubSub = client;
+    m_pushHealthy = false;
+    applyBaseInterval();
+    if (!m_pubSub) return;
+    m_pubSub->setCurrentSymbol(m_currentSymbol);
+    connect(this, &DataPoller::currentSymbolChanged, m_pubSub, &RedisPubSubClient::setCurrentSymbol);
+    connect(m_pubSub, &RedisPubSubClient::healthChanged, this, [this](bool healthy) {
+        m_pushHealthy = healthy;
+        applyBaseInterval();
+        // Push ausgefallen: sofort nachpollen statt bis zu einem Sweep-Intervall veraltet zu bleiben
+        if (!healthy) triggerNow();
+    });
+    connect(m_pubSub, &RedisPubSubClient::reconnected, this, &DataPoller::triggerNow);
+}
+
+void DataPoller::setKeyspaceWatcher(KeyspaceWatcher* watcher) {
+    if (m_keyspace) { disconnect(m_keyspace, nullptr, this, nullptr); disconnect(this, nullptr, m_keyspace, nullptr); }
+    m_keyspace = watcher;
+    m_dirtyKeys.clear();
+    if (!m_keyspace) return;
+    m_keyspace->setKeyPatterns({"market_data", "portfolio_positions", "active_orders", "api_status", "notifications",
+                                "chart_data_*", "chart_bin_*", "predictions_*"});
+    connect(m_keyspace, &KeyspaceWatcher::keyChanged, this, [this](const QString& key, const QString&) {
+        m_dirtyKeys.insert(key.toStdString());
+    });
+    connect(m_keyspace, &KeyspaceWatcher::healthChanged, this, [this](bool healthy) {
+        // Während der Lücke verpasste Events: alles einmal neu holen
+        markAllDirty();
+        if (healthy) triggerNow();
+    });
+    // Neues Symbol: Chart/Predictions sind noch nie geholt worden
+    connect(this, &DataPoller::currentSymbolChanged, m_keyspace, [this]() { markAllDirty(); });
+    markAllDirty();
+}
+
 void DataPoller::start() {
+    if (m_asyncClient) m_asyncClient->connectToServer();
     poll();
     m_timer.start();
 }
 
-void DataPoller::poll() {
-    auto start = std::chrono::steady_clock::now();
-    bool ok = m_client.ping();
-    if (ok != m_connected) {
-        m_connected = ok;
-        emit connectionChanged(m_connected);
+std::vector<std::string> DataPoller::pollKeys() const {
+    std::vector<std::string> keys;
+    keys.reserve(7);
+    // Hash-Layout nur im synchronen Poller (pollMarketHashes), async bleibt beim market_data JSON
+    const bool hashMarket = m_hashMarket && !m_asyncClient;
+    if (!hashMarket && (!m_marketStream || !m_marketStream->isStreaming())) keys.push_back("market_data");
+    if (m_portfolioModel) keys.push_back("portfolio_positions");
+    if (m_ordersModel) keys.push_back("active_orders");
+    if (m_statusModel) keys.push_back("api_status");
+    if (m_notificationsModel) keys.push_back("notifications");
+    // Chart & predictions (optional, nur wenn Modelle gesetzt)
+    if (!m_currentSymbol.isEmpty()) {
+        if (m_chartModel && !chartFromZset()) {
+            keys.push_back((m_chartFormat == ChartFormat::Binary ? "chart_bin_" : "chart_data_") + m_currentSymbol.toStdString());
+        }
+        if (m_predictionsModel) keys.push_back("predictions_" + m_currentSymbol.toStdString());
     }
-    if (!ok) { adjustTimer(false); return; }
+    return keys;
+}
 
-    if (auto val = m_client.get("market_data"); val.has_value()) {
-        m_marketModel->updateFromJson(QByteArray::fromStdString(*val));
+std::vector<std::string> DataPoller::keysToFetch(std::chrono::steady_clock::time_point now) {
+    std::vector<std::string> keys = pollKeys();
+    if (!m_keyspace || !m_keyspace->isHealthy()) return keys;
+    if (now - m_lastFullPoll >= std::chrono::milliseconds(m_sweepIntervalMs)) {
+        m_lastFullPoll = now;
+        m_dirtyKeys.clear();
+        return keys;
+    }
+    // vor dem Request zurücksetzen: ein SET während des Fetch markiert den Key erneut
+    std::vector<std::string> dirty;
+    for (const auto& k : keys) {
+        // Shard-Keys sieht der Keyspace Watcher (Haupt-Endpoint) nicht -> immer holen
+        if (m_dirtyKeys.erase(k) > 0 || shardForKey(k) >= 0) dirty.push_back(k);
     }
-    if (m_portfolioModel) {
-        if (auto val = m_client.get("portfolio_positions"); val.has_value()) {
-            m_portfolioModel->updateFromJson(QByteArray::fromStdString(*val));
+    return dirty;
+}
+
+DataPoller::DecodedBatch DataPoller::decodeBatch(const std::vector<std::string>& keys,
+                                                 const std::vector<std::optional<QByteArray>>& values,
+                                                 const std::shared_ptr<const MarketLayout>& marketLayout) {
+    const auto batchStart = std::chrono::steady_clock::now();
+    DecodedBatch batch;
+    batch.values.reserve(keys.size());
+    for (size_t i = 0; i < keys.size() && i < values.size(); ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        DecodedValue v;
+        v.key = keys[i];
+        v.value = values[i];
+        // Komprimierte Values (ValueCodec) zuerst entpacken, Plain JSON bleibt unverändert
+        if (v.value && ValueCodec::isCompressed(*v.value)) {
+            QByteArray plain;
+            if (ValueCodec::decode(*v.value, plain)) {
+                const qint64 us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+                batch.codec.push_back(CodecSample { v.key, qint64(v.value->size()), qint64(plain.size()), us });
+                v.value = std::move(plain);
+            } else {
+                qWarning() << "corrupt compressed value for" << QString::fromStdString(v.key) << "bytes=" << v.value->size();
+                v.value.reset();
+            }
         }
+        if (v.value) {
+            const QByteArray& bytes = *v.value;
+            const std::string& key = v.key;
+            if (key == "market_data") {
+                MarketSnapshot snapshot;
+                v.valid = MarketModel::decodeSnapshot(bytes, snapshot);
+                if (v.valid && marketLayout) MarketModel::diffSnapshot(snapshot, marketLayout);
+                v.data = std::move(snapshot);
+            } else if (key == "portfolio_positions") {
+                QVector<PortfolioPosition> rows;
+                v.valid = PortfolioModel::decodeRows(bytes, rows);
+                v.data = std::move(rows);
+            } else if (key == "active_orders") {
+                QVector<OrderRow> rows;
+                v.valid = OrdersModel::decodeRows(bytes, rows);
+                v.data = std::move(rows);
+            } else if (key == "notifications") {
+                QVector<NotificationRow> rows;
+                v.valid = NotificationsModel::decodeRows(bytes, rows);
+                v.data = std::move(rows);
+            } else if (key.rfind("chart_data_", 0) == 0) {
+                ChartColumns cols;
+                v.valid = ChartDataModel::decodeColumns(bytes, cols);
+                v.data = std::move(cols);
+            } else if (key.rfind("chart_bin_", 0) == 0) {
+                ChartColumns cols;
+                v.valid = ChartDataModel::decodeBinary(bytes, cols);
+                v.data = std::move(cols);
+            } else if (key.rfind("predictions_", 0) == 0) {
+                QVector<ForecastPoint> points;
+                v.valid = PredictionsModel::decodePoints(bytes, points);
+                v.data = std::move(points);
+            } else {
+                v.valid = true; // api_status: Rohwert, die Komposition braucht Poller-Zustand (GUI Thread)
+            }
+        }
+        v.decodeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+        batch.values.push_back(std::move(v));
     }
-    if (m_ordersModel) {
-        if (auto val = m_client.get("active_orders"); val.has_value()) {
-            m_ordersModel->updateFromJson(QByteArray::fromStdString(*val));
+    batch.decodeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - batchStart).count();
+    return batch;
+}
+
+void DataPoller::recordCodecStats(const std::vector<CodecSample>& samples) {
+    for (const CodecSample& sample : samples) {
+        CodecStats& cs = m_codecStats[sample.key];
+        ++cs.decodes;
+        cs.compressedBytes += sample.compressedBytes;
+        cs.plainBytes += sample.plainBytes;
+        cs.decodeUs += sample.us;
+        if (m_perfLogging) {
+            qInfo() << "decompressed" << QString::fromStdString(sample.key) << sample.compressedBytes << "->" << sample.plainBytes << "bytes"
+                    << "ratio=" << (sample.plainBytes == 0 ? 0.0 : double(sample.compressedBytes) / double(sample.plainBytes))
+                    << "decode(us)=" << sample.us << "avg(us)=" << cs.decodeUs / qint64(cs.decodes);
         }
     }
-    if (m_statusModel) {
-        // Erstelle Status aus mehreren Redis-Keys
-        QJsonObject status;
-        status["redis_connected"] = m_connected; // Wir wissen, dass Redis verbunden ist
-        
-        if (auto val = m_client.get("api_status"); val.has_value()) {
-            QString apiStatus = QString::fromStdString(*val).replace("\"", ""); // Remove quotes
-            status["alpaca_api_active"] = (apiStatus == "valid");
+}
+
+void DataPoller::applyStatus(const std::optional<QByteArray>& val) {
+    if (!m_statusModel) return;
+    m_lastApiStatus = val;
+    // Erstelle Status aus mehreren Redis-Keys
+    QJsonObject status;
+    status["redis_connected"] = m_connected; // Wir wissen, dass Redis verbunden ist
+
+    if (val.has_value()) {
+        QString apiStatus = QString::fromUtf8(*val).replace("\"", ""); // Remove quotes
+        status["alpaca_api_active"] = (apiStatus == "valid");
+    }
+
+    // Weitere Status-Checks hinzufügen
+    status["postgres_connected"] = false; // Setze auf false, da nicht verwendet
+    status["grok_api_active"] = true; // Annahme: Grok läuft
+    status["worker_running"] = true; // Annahme: Worker läuft
+    status["last_heartbeat"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    if (!m_asyncClient && m_client.hasMaster()) {
+        const RedisClient::ReplicationStatus rs = m_client.replicationStatus();
+        status["read_source"] = rs.usingMaster ? "master" : "replica";
+        status["replica_link_up"] = rs.replicaUp && rs.linkUp;
+        status["replication_last_io_s"] = rs.lastIoSeconds;
+        status["replication_lag_bytes"] = double(rs.lagBytes);
+        status["replication_stale"] = rs.stale;
+    }
+
+    QJsonDocument doc(status);
+    m_statusModel->updateFromJson(doc.toJson(QJsonDocument::Compact));
+}
+
+bool DataPoller::isStaleSymbolKey(const std::string& key) const {
+    const size_t n = symbolPrefixLength(key);
+    return n > 0 && key.compare(n, std::string::npos, m_currentSymbol.toStdString()) != 0;
+}
+
+void DataPoller::pollSettled() {
+    m_pollInFlight = false;
+    if (!m_pollPending) return;
+    // triggerNow() während des Zyklus (z.B. Symbolwechsel): nachholen, sobald der laufende Callback zurück ist
+    m_pollPending = false;
+    QTimer::singleShot(0, this, &DataPoller::poll);
+}
+
+void DataPoller::applyDecoded(const DecodedValue& v) {
+    const std::string& key = v.key;
+    if (key == "api_status") { applyStatus(v.value); return; }
+    // Symbol wurde während Fetch/Decode gewechselt: Daten des alten Symbols nicht ins Chart/Prognose-Model
+    if (isStaleSymbolKey(key)) return;
+    if (!v.value.has_value()) return;
+    if (!v.valid) {
+        if (key == "market_data") {
+            qDebug() << "MarketModel: Failed to parse data format:" << QString::fromUtf8(v.value->left(100)) << "...";
+        } else if (key.rfind("chart_bin_", 0) == 0) {
+            qWarning() << "invalid binary chart" << QString::fromStdString(key) << "bytes=" << v.value->size();
         }
-        
-        // Weitere Status-Checks hinzufügen
-        status["postgres_connected"] = false; // Setze auf false, da nicht verwendet
-        status["grok_api_active"] = true; // Annahme: Grok läuft
-        status["worker_running"] = true; // Annahme: Worker läuft
-        status["last_heartbeat"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-        
-        QJsonDocument doc(status);
-        m_statusModel->updateFromJson(doc.toJson(QJsonDocument::Compact));
-    }
-    if (m_notificationsModel) {
-        if (auto val = m_client.get("notifications"); val.has_value()) {
-            m_notificationsModel->updateFromJson(QByteArray::fromStdString(*val));
+        return;
+    }
+    if (const auto* snapshot = std::get_if<MarketSnapshot>(&v.data)) {
+        m_marketModel->applySnapshot(*snapshot);
+    } else if (const auto* positions = std::get_if<QVector<PortfolioPosition>>(&v.data)) {
+        if (m_portfolioModel) m_portfolioModel->setRows(*positions);
+    } else if (const auto* orders = std::get_if<QVector<OrderRow>>(&v.data)) {
+        if (m_ordersModel) m_ordersModel->setRows(*orders);
+    } else if (const auto* notifications = std::get_if<QVector<NotificationRow>>(&v.data)) {
+        if (m_notificationsModel) m_notificationsModel->setRows(*notifications);
+    } else if (const auto* cols = std::get_if<ChartColumns>(&v.data)) {
+        if (!m_chartModel) return;
+        m_chartModel->applyColumns(*cols);
+        if (m_perfLogging && key.rfind("chart_bin_", 0) == 0) {
+            qInfo() << "chart_bin load candles=" << cols->t.size() << "us=" << v.decodeUs;
         }
+    } else if (const auto* points = std::get_if<QVector<ForecastPoint>>(&v.data)) {
+        if (m_predictionsModel) m_predictionsModel->setPoints(*points);
     }
-    // Chart & predictions (optional, nur wenn Modelle gesetzt)
-    if (m_chartModel && !m_currentSymbol.isEmpty()) {
-        std::string key = std::string("chart_data_") + m_currentSymbol.toStdString();
-        if (auto val = m_client.get(key.c_str()); val.has_value()) {
-            m_chartModel->updateFromJson(QByteArray::fromStdString(*val));
+}
+
+void DataPoller::decodeAndFinish(std::vector<std::string> keys, std::vector<std::optional<QByteArray>> values,
+                                 std::chrono::steady_clock::time_point start) {
+    std::shared_ptr<const MarketLayout> layout = m_marketModel->layout();
+    if (!m_decodeThread) {
+        pollSettled();
+        finishPoll(true, keys, std::make_shared<const DecodedBatch>(decodeBatch(keys, values, layout)), start);
+        return;
+    }
+    QMetaObject::invokeMethod(m_decodeContext.get(), [this, keys = std::move(keys), values = std::move(values), layout, start] {
+        auto batch = std::make_shared<const DecodedBatch>(decodeBatch(keys, values, layout));
+        QMetaObject::invokeMethod(this, [this, keys, batch, start] {
+            pollSettled();
+            finishPoll(true, keys, batch, start);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void DataPoller::poll() {
+    auto start = std::chrono::steady_clock::now();
+    if (m_pollInFlight) {
+        // vorheriger Zyklus noch unterwegs (Async Modus oder Decode-Thread): danach einmal neu pollen
+        m_pollPending = true;
+        return;
+    }
+    std::vector<std::string> keys = keysToFetch(start);
+    if (m_asyncClient) {
+        if (!m_asyncClient->isConnected()) { finishPoll(false, keys, nullptr, start); return; }
+        m_pollInFlight = true;
+        m_asyncClient->pipelineGet(keys, [this, keys, start](bool ok, std::vector<std::optional<QByteArray>> values) {
+            if (!ok) {
+                pollSettled();
+                finishPoll(false, keys, nullptr, start);
+                return;
+            }
+            decodeAndFinish(keys, std::move(values), start);
+        });
+        return;
+    }
+    if (m_decodeThread) {
+        // Replikations-Probe, market:* Hashes, chart_zset, Haupt-Fetch und Decode im Decode-Thread (dort Heap statt Arena);
+        // bis zur Rückmeldung startet kein neuer Zyklus, die Redis Clients und m_digests gehören solange dem Decode-Thread.
+        // Model-Zustand (Layout, chart_zset Bereich) wird vorher hier gelesen, die Ergebnisse danach hier angewendet
+        m_pollInFlight = true;
+        const bool hashMarket = m_hashMarket;
+        const std::optional<ChartZsetRequest> chartRequest = chartZsetRequest(start);
+        std::shared_ptr<const MarketLayout> layout = m_marketModel->layout();
+        QMetaObject::invokeMethod(m_decodeContext.get(), [this, keys = std::move(keys), hashMarket, chartRequest, layout, start]() mutable {
+            if (m_client.hasMaster()) m_client.probeReplication();
+            MarketHashResult market;
+            QVector<Candle> candles;
+            const bool sideOk = (!hashMarket || fetchMarketHashes(start, market))
+                                && (!chartRequest || fetchChartZset(*chartRequest, candles));
+            FetchResult fetched;
+            std::shared_ptr<const DecodedBatch> batch;
+            if (sideOk) {
+                fetched = fetchValues(std::move(keys));
+                if (fetched.ok) batch = std::make_shared<const DecodedBatch>(decodeBatch(fetched.keys, fetched.values, layout));
+                fetched.values.clear(); // entpackt im Batch
+            } else {
+                fetched.keys = std::move(keys);
+            }
+            QMetaObject::invokeMethod(this, [this, sideOk, hashMarket, chartRequest, market = std::move(market),
+                                             candles = std::move(candles), fetched = std::move(fetched), batch, start] {
+                if (sideOk) {
+                    if (hashMarket) applyMarketHashes(market, start);
+                    // Merge unmöglich: direkt im Anschluss ein Zyklus mit Voll-Abgleich
+                    if (chartRequest && !applyChartZset(*chartRequest, candles, start)) m_pollPending = true;
+                }
+                pollSettled();
+                storeDigests(fetched.digests);
+                finishPoll(fetched.ok, fetched.keys, batch, start);
+            }, Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+        return;
+    }
+    // Alle hiredis Allokationen dieses (synchronen) Zyklus aus der Arena, Reset vor dem Anwenden der Werte
+    HiredisArena::Cycle arenaCycle;
+    // Lesequelle (Replica/Master) vor den Reads des Zyklus bestimmen
+    if (m_client.hasMaster()) m_client.probeReplication();
+    if ((m_hashMarket && !pollMarketHashes(start)) || !pollChartZset(start)) {
+        arenaCycle.finish();
+        finishPoll(false, keys, nullptr, start);
+        return;
+    }
+    FetchResult fetched = fetchValues(std::move(keys));
+    arenaCycle.finish();
+    storeDigests(fetched.digests);
+    std::shared_ptr<const DecodedBatch> batch;
+    if (fetched.ok) {
+        batch = std::make_shared<const DecodedBatch>(decodeBatch(fetched.keys, fetched.values, m_marketModel->layout()));
+    }
+    finishPoll(fetched.ok, fetched.keys, batch, start);
+}
+
+DataPoller::FetchResult DataPoller::fetchValues(std::vector<std::string> keys) {
+    // Shard-Keys herauslösen und parallel zum Haupt-Fetch holen (ein Thread + ein Pipeline-Batch pro Shard;
+    // Shard-Threads allokieren am Heap, die Arena gilt nur im GUI Thread)
+    std::vector<ShardBatch> shardBatches(m_shards.size());
+    if (!m_shards.empty()) {
+        std::vector<std::string> mainKeys;
+        for (auto& key : keys) {
+            const int s = shardForKey(key);
+            if (s >= 0) shardBatches[static_cast<size_t>(s)].keys.push_back(std::move(key));
+            else mainKeys.push_back(std::move(key));
         }
+        keys = std::move(mainKeys);
     }
-    if (m_predictionsModel && !m_currentSymbol.isEmpty()) {
-        std::string key = std::string("predictions_") + m_currentSymbol.toStdString();
-        if (auto val = m_client.get(key.c_str()); val.has_value()) {
-            m_predictionsModel->updateFromJson(QByteArray::fromStdString(*val));
+    // Jobs laufen detached auf eigenem Batch + geteiltem Client: ein hängender Shard hält den Zyklus nicht länger
+    // als das Warte-Budget auf (zählt als Miss) und belegt seinen Client, bis er selbst zurückkehrt
+    struct ShardJob {
+        size_t shard;
+        std::shared_ptr<ShardBatch> batch;
+        std::future<void> done;
+    };
+    std::vector<ShardJob> shardJobs;
+    const auto shardDeadline = std::chrono::steady_clock::now()
+                               + std::chrono::milliseconds(std::max(kShardWaitMs, m_client.timeoutMs()));
+    for (size_t s = 0; s < shardBatches.size(); ++s) {
+        if (shardBatches[s].keys.empty()) continue;
+        std::shared_ptr<RedisClient> lease = leaseShard(s);
+        if (!lease) continue; // Job aus einem früheren Zyklus läuft noch -> Miss (ok bleibt false)
+        auto batch = std::make_shared<ShardBatch>();
+        batch->keys = shardBatches[s].keys;
+        std::promise<void> promise;
+        shardJobs.push_back(ShardJob { s, batch, promise.get_future() });
+        std::thread([lease = std::move(lease), batch, promise = std::move(promise)]() mutable {
+            batch->ok = lease->pipelineGet(batch->keys, batch->values);
+            lease.reset(); // Shard wieder frei, bevor der Zyklus das Ergebnis sieht
+            promise.set_value();
+        }).detach();
+    }
+
+    FetchResult result;
+    std::vector<std::optional<QByteArray>> values;
+    bool ok = false;
+    if (m_digestMode) {
+        std::vector<std::string> digests;
+        digests.reserve(keys.size());
+        for (const auto& key : keys) {
+            auto it = m_digests.find(key);
+            digests.push_back(it != m_digests.end() ? it->second : std::string());
+        }
+        std::vector<bool> changed;
+        ok = m_client.pipelineGetIfChanged(keys, digests, values, changed);
+        if (ok) {
+            // Nur geänderte Keys an die Models; unveränderte werden nicht erneut geparst
+            std::vector<std::string> changedKeys;
+            std::vector<std::optional<QByteArray>> changedValues;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                result.digests.emplace_back(keys[i], digests[i]);
+                if (!changed[i]) continue;
+                changedKeys.push_back(keys[i]);
+                changedValues.push_back(std::move(values[i]));
+            }
+            keys = std::move(changedKeys);
+            values = std::move(changedValues);
+        }
+    } else if (m_pipelined) {
+        ok = m_client.pipelineGet(keys, values);
+    } else {
+        ok = m_client.ping();
+        if (ok) {
+            values.reserve(keys.size());
+            for (const auto& key : keys) values.push_back(m_client.get(key));
+        }
+    }
+    for (ShardJob& job : shardJobs) {
+        if (job.done.wait_until(shardDeadline) != std::future_status::ready) continue; // zu langsam -> Miss
+        ShardBatch& b = shardBatches[job.shard];
+        b.ok = job.batch->ok;
+        b.values = std::move(job.batch->values);
+    }
+    if (ok) mergeShardBatches(shardBatches, keys, values);
+    result.ok = ok;
+    result.keys = std::move(keys);
+    if (ok) result.values = std::move(values);
+    return result;
+}
+
+void DataPoller::setShards(const QStringList& endpoints) {
+    m_shards.clear();
+    m_shardNames.clear();
+    for (const QString& ep : endpoints) {
+        QString host = ep.trimmed();
+        if (host.isEmpty()) continue;
+        int port = m_port;
+        const int colon = host.lastIndexOf(':');
+        if (!host.startsWith("unix:") && colon > 0) {
+            port = host.mid(colon + 1).toInt();
+            host = host.left(colon);
+        }
+        m_shardNames.push_back(ep.trimmed().toStdString());
+        ShardConnection shard;
+        shard.client = std::make_shared<RedisClient>(host.toStdString(), port, 0, m_password.toStdString());
+        shard.busy = std::make_shared<std::atomic<bool>>(false);
+        m_shards.push_back(std::move(shard));
+    }
+    configureShards();
+    m_shardRing.setShards(m_shardNames);
+    m_chartSyncSymbol.clear();
+}
+
+int DataPoller::shardForKey(const std::string& key) const {
+    if (m_shards.empty()) return -1;
+    const size_t n = symbolPrefixLength(key);
+    return n > 0 ? m_shardRing.shardFor(key.substr(n)) : -1;
+}
+
+void DataPoller::storeDigests(const std::vector<std::pair<std::string, std::string>>& digests) {
+    for (const auto& d : digests) {
+        // verworfene Werte (altes Symbol) gelten nicht als angewendet
+        if (!isStaleSymbolKey(d.first)) m_digests[d.first] = d.second;
+    }
+}
+
+void DataPoller::configureShards() {
+    for (ShardConnection& shard : m_shards) {
+        shard.client->setTimeoutMs(m_client.timeoutMs());
+        shard.client->setSocketOptions(m_client.socketOptions());
+    }
+}
+
+std::shared_ptr<RedisClient> DataPoller::leaseShard(size_t s) {
+    const ShardConnection& shard = m_shards[s];
+    if (shard.busy->exchange(true)) return nullptr;
+    return std::shared_ptr<RedisClient>(shard.client.get(), [client = shard.client, busy = shard.busy](RedisClient*) {
+        busy->store(false);
+    });
+}
+
+std::shared_ptr<RedisClient> DataPoller::leaseClientForSymbol(const QString& sym) {
+    const int s = m_shards.empty() ? -1 : m_shardRing.shardFor(sym.toStdString());
+    if (s < 0) return std::shared_ptr<RedisClient>(&m_client, [](RedisClient*) {});
+    return leaseShard(static_cast<size_t>(s));
+}
+
+void DataPoller::mergeShardBatches(std::vector<ShardBatch>& batches, std::vector<std::string>& keys,
+                                   std::vector<std::optional<QByteArray>>& values) {
+    for (size_t s = 0; s < batches.size(); ++s) {
+        ShardBatch& b = batches[s];
+        if (b.keys.empty()) continue;
+        if (!b.ok) {
+            // Shard nicht erreichbar: Models behalten den letzten Stand, nächster Zyklus versucht es erneut
+            qWarning() << "shard" << QString::fromStdString(m_shardNames[s]) << "unreachable, keys=" << b.keys.size();
+            continue;
+        }
+        if (m_perfLogging) qInfo() << "shard" << QString::fromStdString(m_shardNames[s]) << "keys=" << b.keys.size();
+        for (size_t i = 0; i < b.keys.size(); ++i) {
+            keys.push_back(std::move(b.keys[i]));
+            values.push_back(std::move(b.values[i]));
         }
     }
+}
+
+bool DataPoller::pollMarketHashes(std::chrono::steady_clock::time_point now) {
+    MarketHashResult result;
+    if (!fetchMarketHashes(now, result)) return false;
+    applyMarketHashes(result, now);
+    return true;
+}
+
+bool DataPoller::fetchMarketHashes(std::chrono::steady_clock::time_point now, MarketHashResult& out) {
+    // Voll-Abgleich beim ersten Mal und alle m_sweepIntervalMs (entfernte Symbole erkennen), sonst ab Cursor.
+    // Inklusiver Cursor: Symbole mit exakt dem Cursor-Score werden erneut geholt, aber keins geht verloren.
+    // m_marketCursor/m_lastMarketSweep ändert nur applyMarketHashes, also nicht während ein Fetch läuft
+    out.full = m_marketCursor.empty() || now - m_lastMarketSweep >= std::chrono::milliseconds(m_sweepIntervalMs);
+    std::vector<std::pair<std::string, double>> members;
+    if (!m_client.zrangeByScore("market:index", out.full ? std::string("-inf") : m_marketCursor, "+inf", members)) return false;
+
+    std::vector<std::string> keys;
+    keys.reserve(members.size());
+    double maxScore = out.full ? 0.0 : std::strtod(m_marketCursor.c_str(), nullptr);
+    for (const auto& m : members) {
+        keys.push_back("market:" + m.first);
+        if (m.second > maxScore) maxScore = m.second;
+    }
+    static const std::vector<std::string> fields { "price", "change", "change_percent" };
+    std::vector<std::vector<std::optional<QByteArray>>> values;
+    if (!m_client.pipelineHmget(keys, fields, values)) return false;
+
+    out.quotes.clear();
+    out.quotes.reserve(members.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (!values[i][0]) continue; // Hash fehlt (Index veraltet)
+        MarketQuote q;
+        q.symbol = QString::fromStdString(members[i].first);
+        q.price = values[i][0]->toDouble();
+        q.change = values[i][1] ? values[i][1]->toDouble() : 0.0;
+        q.changePercent = values[i][2] ? values[i][2]->toDouble() : 0.0;
+        out.quotes.push_back(std::move(q));
+    }
+    out.cursor.clear();
+    if (!members.empty() || out.full) out.cursor = QByteArray::number(maxScore, 'g', 17).toStdString();
+    return true;
+}
+
+void DataPoller::applyMarketHashes(const MarketHashResult& result, std::chrono::steady_clock::time_point now) {
+    m_marketModel->applyQuotes(result.quotes);
+    if (result.full) {
+        QSet<QString> present;
+        for (const auto& q : result.quotes) present.insert(q.symbol);
+        m_marketModel->removeSymbolsNotIn(present);
+        m_lastMarketSweep = now;
+    }
+    if (!result.cursor.empty()) m_marketCursor = result.cursor;
+    if (m_perfLogging) qInfo() << "market hashes" << (result.full ? "full" : "delta") << "symbols=" << result.quotes.size();
+}
+
+bool DataPoller::pollChartZset(std::chrono::steady_clock::time_point now) {
+    const std::optional<ChartZsetRequest> request = chartZsetRequest(now);
+    if (!request) return true;
+    QVector<Candle> candles;
+    if (!fetchChartZset(*request, candles)) return false;
+    if (applyChartZset(*request, candles, now)) return true;
+    return pollChartZset(now); // jetzt als Voll-Abgleich
+}
+
+std::optional<DataPoller::ChartZsetRequest> DataPoller::chartZsetRequest(std::chrono::steady_clock::time_point now) const {
+    if (!chartFromZset() || !m_chartModel || m_currentSymbol.isEmpty()) return std::nullopt;
+    // Voll-Abgleich bei Symbolwechsel, leerem Model und alle m_sweepIntervalMs (getrimmte/korrigierte Historie),
+    // sonst nur ab der laufenden Kerze (inklusiv, sie kann sich noch ändern)
+    ChartZsetRequest request;
+    request.symbol = m_currentSymbol;
+    request.full = m_chartSyncSymbol != m_currentSymbol || m_chartModel->rowCount() == 0
+                   || now - m_lastChartSweep >= std::chrono::milliseconds(m_sweepIntervalMs);
+    request.min = request.full ? std::string("-inf") : std::to_string(m_chartModel->lastTime());
+    return request;
+}
+
+bool DataPoller::fetchChartZset(const ChartZsetRequest& request, QVector<Candle>& candles) {
+    const std::string key = "chart_zset:" + request.symbol.toStdString();
+    std::vector<std::pair<std::string, double>> members;
+    std::shared_ptr<RedisClient> client = leaseClientForSymbol(request.symbol);
+    if (!client) return false; // Shard noch von einem hängenden Fetch-Job belegt
+    const bool fetched = client->zrangeByScore(key, request.min, "+inf", members);
+    client.reset();
+    if (!fetched) return false;
+    candles.clear();
+    candles.reserve(qsizetype(members.size()));
+    for (const auto& m : members) {
+        Candle cd;
+        if (!ChartDataModel::parseCandle(QByteArray::fromStdString(m.first), cd)) continue;
+        cd.t = qint64(m.second); // Score ist maßgeblich
+        candles.push_back(cd);
+    }
+    return true;
+}
+
+bool DataPoller::applyChartZset(const ChartZsetRequest& request, const QVector<Candle>& candles,
+                                std::chrono::steady_clock::time_point now) {
+    // Symbol während des Fetch (Decode-Thread) gewechselt: Kerzen des alten Symbols verwerfen
+    if (request.symbol != m_currentSymbol || !m_chartModel) return true;
+    if (!request.full && !m_chartModel->mergeTail(candles)) {
+        m_chartSyncSymbol.clear();
+        return false;
+    }
+    if (request.full) {
+        m_chartModel->setCandles(candles);
+        m_chartSyncSymbol = m_currentSymbol;
+        m_lastChartSweep = now;
+    }
+    if (m_perfLogging) qInfo() << "chart zset" << (request.full ? "full" : "delta") << "bars=" << candles.size();
+    return true;
+}
+
+void DataPoller::finishPoll(bool ok, const std::vector<std::string>& keys, const std::shared_ptr<const DecodedBatch>& batch,
+                            std::chrono::steady_clock::time_point start) {
+    setConnected(ok);
+    if (!ok || !batch) {
+        // nicht geholte Keys bleiben dirty
+        if (m_keyspace) m_dirtyKeys.insert(keys.begin(), keys.end());
+        adjustTimer(false);
+        return;
+    }
+
+    recordCodecStats(batch->codec);
+    // Apply-Stufe: nur noch Model-Updates (Signale) aus den fertig dekodierten Snapshots
+    const auto applyStart = std::chrono::steady_clock::now();
+    bool statusApplied = false;
+    for (const DecodedValue& v : batch->values) {
+        applyDecoded(v);
+        if (v.key == "api_status") statusApplied = true;
+    }
+    // Status (redis_connected, Heartbeat) auch ohne neuen api_status Wert aktualisieren
+    if (!statusApplied && m_statusModel) applyStatus(m_lastApiStatus);
     adjustTimer(true);
     auto end = std::chrono::steady_clock::now();
+    const qint64 applyUs = std::chrono::duration_cast<std::chrono::microseconds>(end - applyStart).count();
     qint64 ms = std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count();
     bool metricsChangedFlag = false;
     if (m_lastLatencyMs != ms) { m_lastLatencyMs = ms; metricsChangedFlag = true; }
+    if (m_lastDecodeUs != batch->decodeUs) { m_lastDecodeUs = batch->decodeUs; metricsChangedFlag = true; }
+    if (m_lastApplyUs != applyUs) { m_lastApplyUs = applyUs; metricsChangedFlag = true; }
     QString nowIso = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
     if (m_lastPollTime != nowIso) { m_lastPollTime = nowIso; metricsChangedFlag = true; }
     if (metricsChangedFlag) emit metricsChanged();
     if (m_perfLogging) {
-        qInfo() << "poll latency(ms)=" << ms << "interval(ms)=" << m_currentIntervalMs << "failCount=" << m_failCount;
+        const char* mode = m_asyncClient ? "async" : (m_digestMode ? "digest" : (m_pipelined ? "pipelined" : "sequential"));
+        qInfo() << "poll latency(ms)=" << ms << "interval(ms)=" << m_currentIntervalMs << "failCount=" << m_failCount
+                << "keys=" << keys.size() << mode << (m_pushHealthy ? "sweep" : "");
+        qInfo() << "poll decode(us)=" << batch->decodeUs << (m_decodeThread ? "(decode thread)" : "(gui thread)")
+                << "apply(us)=" << applyUs;
+        if (HiredisArena::isInstalled()) {
+            const HiredisArena::Stats as = HiredisArena::stats();
+            qInfo() << "hiredis arena cycle bytes=" << as.lastCycleBytes << "peak=" << as.peakCycleBytes
+                    << "avg=" << qRound64(as.avgCycleBytes) << "heapFallbacks=" << as.heapFallbacks << "blocks=" << as.liveBlocks;
+        }
+        if (!m_asyncClient && m_client.isTrackingActive()) {
+            const RedisClient::CacheStats cs = m_client.cacheStats();
+            qInfo() << "client cache hits=" << cs.hits << "misses=" << cs.misses << "invalidations=" << cs.invalidations
+                    << "entries=" << cs.entries;
+        }
     }
 }
 
@@ -1,8 +1,22 @@
 #pragma once
 #include <QObject>
+#include <QThread>
 #include <QTimer>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "hashring.h"
 #include "redisclient.h"
+#include "redisasyncclient.h"
+#include "redispubsubclient.h"
+#include "keyspacewatcher.h"
+#include "marketstreamconsumer.h"
 #include "marketmodel.h"
 #include "portfoliomodel.h"
 #include "ordersmodel.h"
@@ -17,6 +31,8 @@ class DataPoller : public QObject {
     Q_PROPERTY(QString currentSymbol READ currentSymbol WRITE setCurrentSymbol NOTIFY currentSymbolChanged)
     Q_PROPERTY(qint64 lastLatencyMs READ lastLatencyMs NOTIFY metricsChanged)
     Q_PROPERTY(QString lastPollTime READ lastPollTime NOTIFY metricsChanged)
+    Q_PROPERTY(qint64 lastDecodeUs READ lastDecodeUs NOTIFY metricsChanged)
+    Q_PROPERTY(qint64 lastApplyUs READ lastApplyUs NOTIFY metricsChanged)
 public:
     explicit DataPoller(MarketModel* market,
                         const QString& host = "127.0.0.1", int port = 6380, const QString& password = QString(),
@@ -25,15 +41,56 @@ public:
                         StatusModel* status = nullptr,
                         NotificationsModel* notifications = nullptr,
                         QObject* parent = nullptr);
+    ~DataPoller() override;
 
     bool isConnected() const { return m_connected; }
     QString currentSymbol() const { return m_currentSymbol; }
     void setCurrentSymbol(const QString& sym) { if (sym==m_currentSymbol) return; m_currentSymbol = sym; emit currentSymbolChanged(m_currentSymbol); }
     void setChartModel(ChartDataModel* m) { m_chartModel = m; }
     void setPredictionsModel(PredictionsModel* m) { m_predictionsModel = m; }
+    // Kerzenquelle: chart_data_<SYM> (JSON), chart_bin_<SYM> (binär, spaltenweise) oder chart_zset:<SYM>
+    // (ZSET nach t, inkrementell ab der letzten Kerze; nur synchroner Poller, async fällt auf JSON zurück)
+    enum class ChartFormat { Json, Binary, SortedSet };
+    void setChartFormat(ChartFormat format) { m_chartFormat = format; m_chartSyncSymbol.clear(); }
     qint64 lastLatencyMs() const { return m_lastLatencyMs; }
     QString lastPollTime() const { return m_lastPollTime; }
+    // Decode-Stufe (Entpacken + Parsen aller Keys) bzw. Apply-Stufe (Model-Updates im GUI Thread) des letzten Polls
+    qint64 lastDecodeUs() const { return m_lastDecodeUs; }
+    qint64 lastApplyUs() const { return m_lastApplyUs; }
     void setPerformanceLogging(bool enabled) { m_perfLogging = enabled; }
+    // Pipelined Modus: PING + alle GETs eines Poll-Zyklus in einem Round-Trip
+    void setPipelinedPolling(bool enabled) { m_pipelined = enabled; }
+    // RESP3 Client-side Caching im synchronen RedisClient: unveränderte Keys kosten keinen Traffic
+    void setClientTracking(bool enabled) { m_client.setClientTracking(enabled); }
+    // TCP_NODELAY / Keepalive / SO_RCVBUF für den synchronen RedisClient (Unix Socket Hosts ignorieren das)
+    void setSocketOptions(const RedisClient::SocketOptions& opts) { m_client.setSocketOptions(opts); configureShards(); }
+    // Symbol-Shards: chart_*/predictions_<SYM> liegen auf N weiteren Redis Instanzen ("host:port" bzw. "unix:/pfad"),
+    // Zuordnung per Consistent Hash Ring über das Symbol. Leere Liste = alles vom Haupt-Endpoint (synchroner Poller)
+    void setShards(const QStringList& endpoints);
+    // Remote Master als Ausweich-Lesequelle wenn die lokale Replica hinterherhängt (synchroner Poller)
+    void setMasterEndpoint(const QString& host, int port, const QString& password, int maxLagSeconds, qint64 maxLagBytes) {
+        m_client.setMasterEndpoint(host.toStdString(), port, password.toStdString());
+        m_client.setMaxReplicationLag(maxLagSeconds, maxLagBytes);
+        configureShards();
+    }
+    // Digest Modus: Server vergleicht SHA1 je Key (Lua/EVALSHA) und schickt nur geänderte Werte (synchroner Poller)
+    void setDigestPolling(bool enabled) { m_digestMode = enabled; if (!enabled) m_digests.clear(); }
+    // Async Modus: Kommandos laufen über RedisAsyncClient auf dem Event Loop (vor start() setzen)
+    void setAsyncMode(bool enabled);
+    // Decode-Thread: Fetch (synchroner Poller) und Decode laufen auf einem eigenen Thread und liefern unveränderliche,
+    // typisierte Snapshots; der GUI Thread wendet sie nur noch an. Im Async Modus wandert nur das Decode (vor start() setzen)
+    void setDecodeThread(bool enabled);
+    // Pub/Sub liefert Echtzeit-Updates; solange der Kanal gesund ist, pollt der Timer nur noch als Konsistenz-Sweep
+    void setPubSubClient(RedisPubSubClient* client);
+    void setSweepIntervalMs(int ms) { m_sweepIntervalMs = ms; applyBaseInterval(); }
+    // Keyspace Notifications markieren Keys als dirty; ein Poll holt dann nur dirty Keys
+    // (plus Voll-Sweep alle m_sweepIntervalMs, falls Events verloren gehen)
+    void setKeyspaceWatcher(KeyspaceWatcher* watcher);
+    // Solange der Stream-Consumer läuft, kommt market_data als Delta aus market_ticks und wird nicht gepollt
+    void setMarketStreamConsumer(MarketStreamConsumer* consumer) { m_marketStream = consumer; }
+    // Hash-Layout: market:<SYM> Hashes + market:index ZSET (Score = letztes Update); nur geänderte Symbole per
+    // ZRANGEBYSCORE + pipelined HMGET holen, ohne JSON (synchroner Poller)
+    void setHashMarketLayout(bool enabled) { m_hashMarket = enabled; m_marketCursor.clear(); }
     Q_INVOKABLE void triggerNow();
 
 public slots:
@@ -63,16 +120,159 @@ private:
     qint64 m_lastLatencyMs { -1 };
     QString m_lastPollTime; // ISO 8601
     bool m_perfLogging {false};
+    bool m_pipelined {false};
+    bool m_digestMode {false};
+    std::unordered_map<std::string, std::string> m_digests; // Key -> SHA1 des zuletzt angewendeten Werts
+    std::unique_ptr<RedisAsyncClient> m_asyncClient; // nur im Async Modus
+    bool m_pollInFlight {false};
+    bool m_pollPending {false};  // triggerNow()/Timer während m_pollInFlight: nach dem Zyklus erneut pollen
+    RedisPubSubClient* m_pubSub {nullptr};
+    bool m_pushHealthy {false};
+    KeyspaceWatcher* m_keyspace {nullptr};
+    MarketStreamConsumer* m_marketStream {nullptr};
+    ChartFormat m_chartFormat {ChartFormat::Json};
+    QString m_chartSyncSymbol;       // Symbol des letzten chart_zset Voll-Abgleichs ("" = Voll-Abgleich fällig)
+    std::chrono::steady_clock::time_point m_lastChartSweep {};
+    bool m_hashMarket {false};
+    std::string m_marketCursor;      // höchster gesehener market:index Score ("" = noch kein Voll-Abgleich)
+    std::chrono::steady_clock::time_point m_lastMarketSweep {};
+    std::set<std::string> m_dirtyKeys;
+    std::chrono::steady_clock::time_point m_lastFullPoll {};
+    // Shard-Verbindungen, geteilt mit laufenden Fetch-Jobs (die das Warte-Budget überdauern können);
+    // busy = Client gerade in Benutzung, ein zweiter Zugriff zählt als Miss
+    struct ShardConnection {
+        std::shared_ptr<RedisClient> client;
+        std::shared_ptr<std::atomic<bool>> busy;
+    };
+    std::vector<ShardConnection> m_shards;
+    std::vector<std::string> m_shardNames;
+    HashRing m_shardRing;
+    std::optional<QByteArray> m_lastApiStatus; // für Status-Komposition wenn api_status nicht neu geholt wird
+    // Komprimierte Values (ValueCodec): je Key kumulierte Bytes und Decode-Zeit für --perf-log
+    struct CodecStats {
+        quint64 decodes = 0;
+        qint64 compressedBytes = 0;
+        qint64 plainBytes = 0;
+        qint64 decodeUs = 0;
+    };
+    std::unordered_map<std::string, CodecStats> m_codecStats;
+
+    qint64 m_lastDecodeUs { -1 };
+    qint64 m_lastApplyUs { -1 };
+    // Nur mit setDecodeThread(true): Thread + Kontextobjekt (lebt im Thread) für QMetaObject::invokeMethod
+    std::unique_ptr<QThread> m_decodeThread;
+    std::unique_ptr<QObject> m_decodeContext;
+
+    // Ergebnis der Decode-Stufe je Key; nach dem Erzeugen unveränderlich, der GUI Thread liest es nur
+    using DecodedData = std::variant<std::monostate, MarketSnapshot, QVector<PortfolioPosition>, QVector<OrderRow>,
+                                     QVector<NotificationRow>, ChartColumns, QVector<ForecastPoint>>;
+    struct DecodedValue {
+        std::string key;
+        std::optional<QByteArray> value; // entpackt; nullopt = Key fehlt oder kaputter Frame
+        DecodedData data;
+        bool valid = false;              // value vorhanden und vom zuständigen Decoder akzeptiert
+        qint64 decodeUs = 0;
+    };
+    struct CodecSample {
+        std::string key;
+        qint64 compressedBytes = 0;
+        qint64 plainBytes = 0;
+        qint64 us = 0;
+    };
+    struct DecodedBatch {
+        std::vector<DecodedValue> values;
+        std::vector<CodecSample> codec; // nur komprimierte Values
+        qint64 decodeUs = 0;
+    };
+    // Fetch-Ergebnis eines synchronen Zyklus (Haupt-Endpoint + Shards; im Digest Modus nur geänderte Keys)
+    struct FetchResult {
+        bool ok = false;
+        std::vector<std::string> keys;
+        std::vector<std::optional<QByteArray>> values;
+        std::vector<std::pair<std::string, std::string>> digests; // Key -> SHA1, übernimmt der GUI Thread in m_digests
+    };
+
+    // Keys eines Poll-Zyklus (abhängig von gesetzten Modellen / currentSymbol)
+    std::vector<std::string> pollKeys() const;
+    // Im Keyspace Modus: nur dirty Keys (werden dabei zurückgesetzt); sonst pollKeys()
+    std::vector<std::string> keysToFetch(std::chrono::steady_clock::time_point now);
+    bool pollMarketHashes(std::chrono::steady_clock::time_point now);
+    bool pollChartZset(std::chrono::steady_clock::time_point now);
+    // market:* Hashes eines Zyklus; Fetch nur über Redis Clients und Cursor (auch im Decode-Thread), Apply im GUI Thread
+    struct MarketHashResult {
+        bool full = false;
+        std::vector<MarketQuote> quotes;
+        std::string cursor; // neuer m_marketCursor, "" = unverändert
+    };
+    bool fetchMarketHashes(std::chrono::steady_clock::time_point now, MarketHashResult& out);
+    void applyMarketHashes(const MarketHashResult& result, std::chrono::steady_clock::time_point now);
+    // chart_zset Bereich, im GUI Thread aus dem Model-Zustand bestimmt (nullopt = kein chart_zset in diesem Zyklus)
+    struct ChartZsetRequest {
+        QString symbol;
+        bool full = false;
+        std::string min;
+    };
+    std::optional<ChartZsetRequest> chartZsetRequest(std::chrono::steady_clock::time_point now) const;
+    bool fetchChartZset(const ChartZsetRequest& request, QVector<Candle>& candles);
+    // false = Merge unmöglich (Model kam aus JSON mit Text-Zeitstempeln), Voll-Abgleich ist vorgemerkt
+    bool applyChartZset(const ChartZsetRequest& request, const QVector<Candle>& candles, std::chrono::steady_clock::time_point now);
+    // Shard-Index für symbolbezogene Keys (chart_data_/chart_bin_/predictions_<SYM>), -1 = Haupt-Endpoint
+    int shardForKey(const std::string& key) const;
+    // Timeout und Socket Optionen von m_client auf alle Shard-Clients übertragen
+    void configureShards();
+    // Exklusiver Zugriff auf einen Shard-Client bis zur Freigabe des Zeigers; nullptr = Shard belegt
+    std::shared_ptr<RedisClient> leaseShard(size_t s);
+    // Haupt-Client (m_client) oder Shard des Symbols
+    std::shared_ptr<RedisClient> leaseClientForSymbol(const QString& sym);
+    // Ein Pipeline-Batch pro Shard eines Poll-Zyklus
+    struct ShardBatch {
+        std::vector<std::string> keys;
+        std::vector<std::optional<QByteArray>> values;
+        bool ok = false;
+    };
+    void mergeShardBatches(std::vector<ShardBatch>& batches, std::vector<std::string>& keys,
+                           std::vector<std::optional<QByteArray>>& values);
+    bool chartFromZset() const { return m_chartFormat == ChartFormat::SortedSet && !m_asyncClient; }
+    void markAllDirty() { for (auto& k : pollKeys()) m_dirtyKeys.insert(k); }
+    // Haupt-Fetch inkl. Shards; berührt nur Redis Clients und Konfiguration -> läuft auch im Decode-Thread
+    FetchResult fetchValues(std::vector<std::string> keys);
+    // Entpacken (ValueCodec) und Parsen in typisierte Snapshots, ohne Model-Zugriff (thread-safe); market_data wird
+    // dabei gegen marketLayout (im GUI Thread geholt) abgeglichen, die Apply-Stufe übernimmt nur noch den Diff
+    static DecodedBatch decodeBatch(const std::vector<std::string>& keys, const std::vector<std::optional<QByteArray>>& values,
+                                    const std::shared_ptr<const MarketLayout>& marketLayout);
+    // Decode im Decode-Thread (falls aktiv) oder direkt, danach finishPoll im GUI Thread
+    void decodeAndFinish(std::vector<std::string> keys, std::vector<std::optional<QByteArray>> values,
+                         std::chrono::steady_clock::time_point start);
+    // Zyklus abgeschlossen: m_pollInFlight zurücksetzen, aufgelaufenen Poll nachholen
+    void pollSettled();
+    // Symbolbezogener Key eines anderen als des aktuellen Symbols (Wechsel während Fetch/Decode)
+    bool isStaleSymbolKey(const std::string& key) const;
+    void storeDigests(const std::vector<std::pair<std::string, std::string>>& digests);
+    // Verteilt einen dekodierten Wert an das zuständige Model
+    void applyDecoded(const DecodedValue& v);
+    // Status-Komposition aus api_status (nullopt = Key fehlt) und Verbindungs-/Replikationszustand
+    void applyStatus(const std::optional<QByteArray>& val);
+    void recordCodecStats(const std::vector<CodecSample>& samples);
+    void finishPoll(bool ok, const std::vector<std::string>& keys, const std::shared_ptr<const DecodedBatch>& batch,
+                    std::chrono::steady_clock::time_point start);
+    void setConnected(bool c) { if (c != m_connected) { m_connected = c; emit connectionChanged(m_connected); } }
     // Backoff
     int m_baseIntervalMs {5000};
     int m_currentIntervalMs {5000};
     int m_failCount {0};
     int m_maxIntervalMs {30000};
+    int m_sweepIntervalMs {30000};
+    int baseInterval() const { return m_pushHealthy ? m_sweepIntervalMs : m_baseIntervalMs; }
+    void applyBaseInterval() {
+        if (m_failCount > 0) return; // Backoff läuft, wird beim nächsten Erfolg zurückgesetzt
+        m_currentIntervalMs = baseInterval();
+        m_timer.setInterval(m_currentIntervalMs);
+    }
     void adjustTimer(bool success) {
         if (success) {
             if (m_failCount>0) {
                 m_failCount = 0;
-                m_currentIntervalMs = m_baseIntervalMs;
+                m_currentIntervalMs = baseInterval();
                 m_timer.setInterval(m_currentIntervalMs);
             }
         } else {
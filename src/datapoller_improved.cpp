@@ -109,6 +109,7 @@ void DataPoller::triggerSpecific(const QStringList& dataTypes) {
     if (!ensureConnection()) return;
     
     auto start = std::chrono::steady_clock::now();
+    const QString symbol = currentSymbol();
     
     for (const QString& dataType : dataTypes) {
         if (dataType == "market" && m_marketModel) {
@@ -120,6 +121,12 @@ void DataPoller::triggerSpecific(const QStringList& dataTypes) {
         } else if (dataType == "orders" && m_ordersModel) {
             fetchAndUpdate("active_orders", "orders",
                 [this](const QByteArray& data) { m_ordersModel->updateFromJson(data); });
+        } else if (dataType == "chart" && m_chartModel && !symbol.isEmpty()) {
+            fetchAndUpdate("chart_data_" + symbol, "chart",
+                [this](const QByteArray& data) { m_chartModel->updateFromJson(data); });
+        } else if (dataType == "predictions" && m_predictionsModel && !symbol.isEmpty()) {
+            fetchAndUpdate("predictions_" + symbol, "predictions",
+                [this](const QByteArray& data) { m_predictionsModel->updateFromJson(data); });
         }
     }
     
@@ -137,18 +144,20 @@ void DataPoller::setPollingStrategy(PollingStrategy strategy) {
 }
 
 void DataPoller::setCurrentSymbol(const QString& symbol) {
-    if (m_currentSymbol != symbol) {
+    {
+        QMutexLocker lock(&m_symbolMutex);
+        if (m_currentSymbol == symbol) return;
         m_currentSymbol = symbol;
+    }
+    
+    // Trigger immediate update for new symbol data
+    if (!symbol.isEmpty() && m_running.load()) {
+        QStringList chartUpdates;
+        if (m_chartModel) chartUpdates << "chart";
+        if (m_predictionsModel) chartUpdates << "predictions";
         
-        // Trigger immediate update for new symbol data
-        if (!symbol.isEmpty() && m_running.load()) {
-            QStringList chartUpdates;
-            if (m_chartModel) chartUpdates << "chart";
-            if (m_predictionsModel) chartUpdates << "predictions";
-            
-            if (!chartUpdates.isEmpty()) {
-                triggerSpecific(chartUpdates);
-            }
+        if (!chartUpdates.isEmpty()) {
+            triggerSpecific(chartUpdates);
         }
     }
 }
@@ -261,9 +270,10 @@ void DataPoller::poll() {
         }
         
         // Chart and predictions (if symbol selected)
-        if (!m_currentSymbol.isEmpty()) {
+        const QString symbol = currentSymbol();
+        if (!symbol.isEmpty()) {
             if (m_chartModel) {
-                std::string key = "chart_data_" + m_currentSymbol.toStdString();
+                std::string key = "chart_data_" + symbol.toStdString();
                 if (fetchAndUpdate(QString::fromStdString(key), "chart",
                     [this](const QByteArray& data) { m_chartModel->updateFromJson(data); })) {
                     updatesPerformed++;
@@ -271,7 +281,7 @@ void DataPoller::poll() {
             }
             
             if (m_predictionsModel) {
-                std::string key = "predictions_" + m_currentSymbol.toStdString();
+                std::string key = "predictions_" + symbol.toStdString();
                 if (fetchAndUpdate(QString::fromStdString(key), "predictions",
                     [this](const QByteArray& data) { m_predictionsModel->updateFromJson(data); })) {
                     updatesPerformed++;
@@ -470,12 +480,39 @@ void DataPoller::adjustIntervalPowerSave() {
 
 bool DataPoller::fetchAndUpdate(const QString& key, const QString& dataType, 
                                std::function<void(const QByteArray&)> updateFunc) {
+    // Läuft für denselben Key schon ein Fetch (anderer Thread / Trigger), auf dessen Ergebnis warten statt
+    // dieselben Daten ein zweites Mal zu holen und zu parsen
+    auto flight = m_fetchFlight.run(key.toStdString(), [&]() { return fetchAndUpdateOnce(key, dataType, updateFunc); });
+    if (flight.shared) {
+        QMutexLocker lock(&m_statsMutex);
+        m_stats.coalescedFetches++;
+    }
+    return flight.value;
+}
+
+bool DataPoller::isCurrentSymbolKey(const QString& key) const {
+    QString symbol;
+    if (key.startsWith(QLatin1String("chart_data_"))) symbol = key.mid(11);
+    else if (key.startsWith(QLatin1String("predictions_"))) symbol = key.mid(12);
+    else return true;
+    QMutexLocker lock(&m_symbolMutex);
+    return symbol == m_currentSymbol;
+}
+
+bool DataPoller::fetchAndUpdateOnce(const QString& key, const QString& dataType,
+                                    const std::function<void(const QByteArray&)>& updateFunc) {
     auto client = getClient();
     if (!client) return false;
     
     auto result = client->getWithResult(key.toStdString());
     
     if (result.hasValue()) {
+        // Symbol inzwischen gewechselt: nicht mehr parsen, sonst überschreibt ein später Fetch den neuen Chart
+        if (!isCurrentSymbolKey(key)) {
+            QMutexLocker lock(&m_statsMutex);
+            m_stats.staleDiscarded++;
+            return false;
+        }
         QByteArray data = QByteArray::fromStdString(result.value.value());
         updateFunc(data);
         emit dataUpdated(dataType);
@@ -8,6 +8,7 @@
 #include <atomic>
 #include <queue>
 #include "redisclient_improved.h"
+#include "singleflight.h"
 
 // Forward declarations
 class MarketModel;
@@ -70,6 +71,7 @@ public:
     void setChartModel(ChartDataModel* model) { m_chartModel = model; }
     void setPredictionsModel(PredictionsModel* model) { m_predictionsModel = model; }
     void setCurrentSymbol(const QString& symbol);
+    QString currentSymbol() const { QMutexLocker lock(&m_symbolMutex); return m_currentSymbol; }
     
     // Performance settings
     void setPerformanceLogging(bool enable) { m_perfLogging = enable; }
@@ -92,6 +94,8 @@ public:
         qint64 minLatencyMs = INT64_MAX;
         qint64 maxLatencyMs = 0;
         double avgLatencyMs = 0.0;
+        size_t coalescedFetches = 0;   // Fetch eines anderen Aufrufers für denselben Key mitbenutzt
+        size_t staleDiscarded = 0;     // Chart/Predictions für nicht mehr gewähltes Symbol verworfen
     };
     
     PollStatistics getStatistics() const;
@@ -146,7 +150,8 @@ private:
     QString m_host;
     int m_port;
     QString m_password;
-    QString m_currentSymbol;
+    QString m_currentSymbol;           // geschützt durch m_symbolMutex (Fetches laufen ggf. in Worker-Threads)
+    mutable QMutex m_symbolMutex;
     
     // Polling settings
     PollingStrategy m_strategy = PollingStrategy::Adaptive;
@@ -174,6 +179,9 @@ private:
     mutable QMutex m_statsMutex;
     PollStatistics m_stats;
     
+    // Single-Flight pro Redis Key: Timer, triggerNow, triggerSpecific und Symbolwechsel teilen sich Fetch + Parse
+    SingleFlight<bool> m_fetchFlight;
+
     // Priority queue for updates
     std::priority_queue<UpdateTask> m_updateQueue;
     mutable QMutex m_queueMutex;
@@ -186,6 +194,9 @@ private:
     void adjustIntervalRealTime();
     void adjustIntervalPowerSave();
     bool fetchAndUpdate(const QString& key, const QString& dataType, std::function<void(const QByteArray&)> updateFunc);
+    bool fetchAndUpdateOnce(const QString& key, const QString& dataType, const std::function<void(const QByteArray&)>& updateFunc);
+    // false für chart_data_<SYM>/predictions_<SYM> wenn <SYM> nicht mehr das gewählte Symbol ist
+    bool isCurrentSymbolKey(const QString& key) const;
     void updateStatistics(bool success, qint64 latencyMs);
     void handleError(const QString& error);
     void clearError();
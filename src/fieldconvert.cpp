@@ -0,0 +1,187 @@
+// Zahlen- und ISO-8601 Konvertierung ohne QString/QDateTime Umweg (siehe fieldconvert.h)
+#include "fieldconvert.h"
+#include <QJsonValue>
+#include <cmath>
+#include <cstdio>
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+
+namespace {
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+void trim(const char*& p, const char*& end) {
+    while (p < end && isSpace(*p)) ++p;
+    while (end > p && isSpace(end[-1])) --end;
+}
+
+bool readDigits(const char*& p, const char* end, int count, int& out) {
+    if (end - p < count) return false;
+    int v = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!isDigit(p[i])) return false;
+        v = v * 10 + (p[i] - '0');
+    }
+    p += count;
+    out = v;
+    return true;
+}
+
+bool expect(const char*& p, const char* end, char c) {
+    if (p == end || *p != c) return false;
+    ++p;
+    return true;
+}
+
+bool isLeapYear(int y) { return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0; }
+
+int daysInMonth(int y, int m) {
+    static const int kDays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return m == 2 && isLeapYear(y) ? 29 : kDays[m - 1];
+}
+
+// Tage seit 1970-01-01 im proleptischen Gregorianischen Kalender (days_from_civil nach H. Hinnant)
+qint64 daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const qint64 era = (y >= 0 ? y : y - 399) / 400;
+    const qint64 yoe = y - era * 400;
+    const qint64 doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const qint64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void civilFromDays(qint64 z, qint64& y, int& m, int& d) {
+    z += 719468;
+    const qint64 era = (z >= 0 ? z : z - 146096) / 146097;
+    const qint64 doe = z - era * 146097;
+    const qint64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const qint64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const qint64 mp = (5 * doy + 2) / 153;
+    d = int(doy - (153 * mp + 2) / 5 + 1);
+    m = int(mp < 10 ? mp + 3 : mp - 9);
+    y = yoe + era * 400 + (m <= 2);
+}
+} // namespace
+
+namespace FieldConvert {
+
+bool parseDouble(const char* text, size_t length, double& out) {
+    const char* p = text;
+    const char* end = text + length;
+    trim(p, end);
+    if (p < end && *p == '+') {
+        ++p;
+        if (p < end && *p == '-') return false;
+    }
+    if (p == end) return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    double v = 0.0;
+    const auto res = std::from_chars(p, end, v);
+    if (res.ec != std::errc() || res.ptr != end) return false;
+#else
+    // Standardbibliothek ohne from_chars für double (ältere libc++): locale-unabhängiger Qt Parser
+    bool ok = false;
+    const double v = QByteArray::fromRawData(p, int(end - p)).toDouble(&ok);
+    if (!ok) return false;
+#endif
+    out = v;
+    return true;
+}
+
+double numberValue(const QJsonValue& v) {
+    if (v.isString()) return toDouble(v.toString().toUtf8());
+    return v.toDouble();
+}
+
+std::optional<qint64> parseIsoMillis(const char* text, size_t length) {
+    const char* p = text;
+    const char* end = text + length;
+    trim(p, end);
+    int year = 0, month = 0, day = 0;
+    if (!readDigits(p, end, 4, year) || !expect(p, end, '-') || !readDigits(p, end, 2, month) || !expect(p, end, '-')
+        || !readDigits(p, end, 2, day)) {
+        return std::nullopt;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return std::nullopt;
+
+    int hour = 0, minute = 0, second = 0, millis = 0, offsetMinutes = 0;
+    if (p != end) {
+        if (*p != 'T' && *p != 't' && *p != ' ') return std::nullopt;
+        ++p;
+        if (!readDigits(p, end, 2, hour) || !expect(p, end, ':') || !readDigits(p, end, 2, minute)) return std::nullopt;
+        if (p < end && *p == ':' && (++p, !readDigits(p, end, 2, second))) return std::nullopt;
+        if (p < end && (*p == '.' || *p == ',')) {
+            ++p;
+            int digits = 0;
+            for (; p < end && isDigit(*p); ++p, ++digits) {
+                if (digits < 3) millis = millis * 10 + (*p - '0');
+            }
+            if (digits == 0) return std::nullopt;
+            for (; digits < 3; ++digits) millis *= 10;
+        }
+        if (p < end) {
+            if (*p == 'Z' || *p == 'z') {
+                ++p;
+            } else if (*p == '+' || *p == '-') {
+                const int sign = *p == '-' ? -1 : 1;
+                ++p;
+                int oh = 0, om = 0;
+                if (!readDigits(p, end, 2, oh)) return std::nullopt;
+                if (p < end && *p == ':') ++p;
+                if (p < end && !readDigits(p, end, 2, om)) return std::nullopt;
+                if (oh > 23 || om > 59) return std::nullopt;
+                offsetMinutes = sign * (oh * 60 + om);
+            } else {
+                return std::nullopt;
+            }
+        }
+        if (p != end) return std::nullopt;
+        if (hour > 23 || minute > 59 || second > 60) return std::nullopt;
+        if (second == 60) second = 59; // Schaltsekunde
+    }
+    const qint64 secs = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - qint64(offsetMinutes) * 60;
+    return secs * 1000 + millis;
+}
+
+EpochMs timestampFromNumber(double v) {
+    if (!std::isfinite(v) || v <= 0.0) return {};
+    return EpochMs { v < 1e11 ? std::llround(v * 1000.0) : std::llround(v), QString() };
+}
+
+EpochMs timestampFromText(const char* text, size_t length) {
+    if (const auto ms = parseIsoMillis(text, length)) return EpochMs { *ms, QString() };
+    double v = 0.0;
+    EpochMs t;
+    if (parseDouble(text, length, v)) t = timestampFromNumber(v);
+    // nicht lesbar (z.B. "gestern 14:00"): wie früher unverändert anzeigen
+    if (!t.isValid()) t.text = QString::fromUtf8(text, static_cast<int>(length));
+    return t;
+}
+
+EpochMs timestampValue(const QJsonValue& v) {
+    if (v.isString()) return timestampFromText(v.toString().toUtf8());
+    if (v.isDouble()) return timestampFromNumber(v.toDouble());
+    return {};
+}
+
+QString formatIsoMillis(const EpochMs& t) {
+    if (!t.isValid()) return t.text;
+    const qint64 dayMs = 86400000;
+    qint64 days = t.ms / dayMs;
+    qint64 rest = t.ms % dayMs;
+    if (rest < 0) { rest += dayMs; --days; }
+    qint64 y = 0;
+    int m = 0, d = 0;
+    civilFromDays(days, y, m, d);
+    const int secs = int(rest / 1000);
+    const int millis = int(rest % 1000);
+    char buf[40];
+    int n = std::snprintf(buf, sizeof(buf), "%04lld-%02d-%02dT%02d:%02d:%02d", static_cast<long long>(y), m, d,
+                          secs / 3600, (secs / 60) % 60, secs % 60);
+    if (millis) n += std::snprintf(buf + n, sizeof(buf) - size_t(n), ".%03d", millis);
+    buf[n++] = 'Z';
+    return QString::fromLatin1(buf, n);
+}
+
+} // namespace FieldConvert
@@ -0,0 +1,50 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <cstddef>
+#include <optional>
+
+class QJsonValue;
+
+// Gemeinsame Feld-Konvertierung für Broker-Payloads (Alpaca liefert Zahlen als Strings, Zeitstempel als ISO-8601).
+// Zahlen per std::from_chars direkt aus den Rohbytes (ohne QString/Locale), Zeitstempel ohne QDateTime in epoch ms.
+// Models speichern die typisierten Werte und formatieren erst in data() für die Anzeige.
+
+// Zeitstempel als epoch Millisekunden (UTC); 0 = fehlt oder nicht lesbar
+struct EpochMs {
+    qint64 ms = 0;
+    QString text; // nur bei nicht lesbarem Text: Original für die Anzeige
+    bool isValid() const { return ms != 0; }
+    bool operator==(const EpochMs& other) const { return ms == other.ms && text == other.text; }
+};
+
+namespace FieldConvert {
+
+// Ganzer Text muss eine Zahl sein (Whitespace und führendes '+' erlaubt); out bleibt sonst unverändert
+bool parseDouble(const char* text, size_t length, double& out);
+inline double toDouble(const char* text, size_t length, double fallback = 0.0) {
+    double v = fallback;
+    parseDouble(text, length, v);
+    return v;
+}
+inline double toDouble(const QByteArray& utf8, double fallback = 0.0) {
+    return toDouble(utf8.constData(), static_cast<size_t>(utf8.size()), fallback);
+}
+// JSON Zahl oder numerischer String (Worker schreiben beides)
+double numberValue(const QJsonValue& v);
+
+// YYYY-MM-DD[(T| )HH:MM[:SS[.f...]]][Z|±HH[:]MM]; ohne Offset gilt UTC
+std::optional<qint64> parseIsoMillis(const char* text, size_t length);
+// ISO-8601 oder Zahl (< 1e11 epoch Sekunden, sonst Millisekunden); ungültig -> ms 0, text = Eingabe
+EpochMs timestampFromText(const char* text, size_t length);
+inline EpochMs timestampFromText(const QByteArray& utf8) {
+    return timestampFromText(utf8.constData(), static_cast<size_t>(utf8.size()));
+}
+EpochMs timestampValue(const QJsonValue& v);
+EpochMs timestampFromNumber(double v);
+
+// "2025-09-13T14:25:30Z" bzw. mit ".123" wenn Millisekunden gesetzt sind; ungültig -> Originaltext (bzw. leer)
+QString formatIsoMillis(const EpochMs& t);
+
+} // namespace FieldConvert
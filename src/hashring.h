@@ -0,0 +1,50 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Consistent Hash Ring: jeder Shard belegt kVirtualNodes Punkte auf einem 64-bit Ring, ein Key gehört dem ersten
+// Punkt im Uhrzeigersinn. Kommt ein Shard hinzu oder fällt weg, wandern nur die Keys seiner Punkte (~1/N).
+// Gehasht werden die Shard-Namen (z.B. "host:port"), nicht die Indizes: Reihenfolge der Shards ist egal.
+class HashRing {
+public:
+    static constexpr int kVirtualNodes = 128;
+
+    void setShards(const std::vector<std::string>& names) {
+        m_ring.clear();
+        m_ring.reserve(names.size() * kVirtualNodes);
+        for (size_t s = 0; s < names.size(); ++s) {
+            for (int v = 0; v < kVirtualNodes; ++v) {
+                m_ring.emplace_back(hash(names[s] + '#' + std::to_string(v)), static_cast<int>(s));
+            }
+        }
+        std::sort(m_ring.begin(), m_ring.end());
+        m_shardCount = names.size();
+    }
+
+    size_t shardCount() const { return m_shardCount; }
+
+    // Index in names aus setShards(), -1 wenn keine Shards gesetzt sind
+    int shardFor(const std::string& key) const {
+        if (m_ring.empty()) return -1;
+        auto it = std::lower_bound(m_ring.begin(), m_ring.end(), std::make_pair(hash(key), 0));
+        if (it == m_ring.end()) it = m_ring.begin();
+        return it->second;
+    }
+
+    // FNV-1a + splitmix64 Finalizer: plattformunabhängig stabil (anders als std::hash), gut verteilt
+    static uint64_t hash(const std::string& s) {
+        uint64_t h = 1469598103934665603ULL;
+        for (unsigned char c : s) { h ^= c; h *= 1099511628211ULL; }
+        h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+private:
+    std::vector<std::pair<uint64_t, int>> m_ring;
+    size_t m_shardCount {0};
+};
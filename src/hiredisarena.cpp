@@ -0,0 +1,202 @@
+// Arena Allocator für hiredis (siehe hiredisarena.h)
+#include "hiredisarena.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if !defined(REDIS_STUB)
+#if defined(HIREDIS_VENDORED)
+#include <alloc.h>
+#else
+#include <hiredis/alloc.h>
+#endif
+#endif
+
+namespace {
+
+struct Block {
+    // Lebende Allokationen + 1 solange der Block der aktuelle Arena-Block ist; wer auf 0 zählt, gibt frei
+    std::atomic<size_t> refs {1};
+    size_t used {0};
+    size_t capacity {0};
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+// Header vor jeder Allokation (auch Heap), damit free/realloc die Herkunft kennen
+struct alignas(alignof(std::max_align_t)) Header {
+    Block* block; // nullptr = Heap
+    size_t size;
+};
+
+constexpr size_t kAlign = alignof(std::max_align_t);
+constexpr size_t alignUp(size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+size_t g_blockSize = 256 * 1024;
+size_t g_maxArenaAlloc = 64 * 1024;
+bool g_installed = false;
+std::atomic<size_t> g_liveBlocks {0};
+
+// Statistik (nur vom Zyklus-Thread geschrieben, Lesen über Mutex-Snapshot)
+std::mutex g_statsMutex;
+HiredisArena::Stats g_stats;
+double g_totalCycleBytes = 0.0;
+
+thread_local bool t_inCycle = false;
+thread_local Block* t_current = nullptr;
+thread_local size_t t_cycleBytes = 0;
+thread_local quint64 t_cycleAllocs = 0;
+thread_local quint64 t_cycleFallbacks = 0;
+
+Block* newBlock() {
+    void* mem = std::malloc(sizeof(Block) + g_blockSize);
+    if (!mem) return nullptr;
+    Block* b = new (mem) Block();
+    b->capacity = g_blockSize;
+    g_liveBlocks.fetch_add(1, std::memory_order_relaxed);
+    return b;
+}
+
+void releaseRef(Block* b) {
+    if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        b->~Block();
+        std::free(b);
+        g_liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void* heapAlloc(size_t size) {
+    auto* h = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+    if (!h) return nullptr;
+    h->block = nullptr;
+    h->size = size;
+    return h + 1;
+}
+
+void* arenaMalloc(size_t size) {
+    if (!t_inCycle || size > g_maxArenaAlloc) {
+        if (t_inCycle) ++t_cycleFallbacks;
+        return heapAlloc(size);
+    }
+    const size_t need = sizeof(Header) + alignUp(size);
+    if (!t_current || t_current->used + need > t_current->capacity) {
+        if (t_current) releaseRef(t_current); // voll: ausmustern, lebt bis zum letzten free
+        t_current = newBlock();
+        if (!t_current) return heapAlloc(size);
+    }
+    auto* h = reinterpret_cast<Header*>(t_current->data() + t_current->used);
+    t_current->used += need;
+    t_current->refs.fetch_add(1, std::memory_order_relaxed);
+    h->block = t_current;
+    h->size = size;
+    t_cycleBytes += need;
+    ++t_cycleAllocs;
+    return h + 1;
+}
+
+void arenaFree(void* ptr) {
+    if (!ptr) return;
+    Header* h = static_cast<Header*>(ptr) - 1;
+    if (h->block) releaseRef(h->block);
+    else std::free(h);
+}
+
+void* arenaCalloc(size_t nmemb, size_t size) {
+    const size_t total = nmemb * size; // Overflow prüft hi_calloc
+    void* p = arenaMalloc(total);
+    if (p) std::memset(p, 0, total);
+    return p;
+}
+
+void* arenaRealloc(void* ptr, size_t size) {
+    if (!ptr) return arenaMalloc(size);
+    Header* h = static_cast<Header*>(ptr) - 1;
+    if (h->block && h->block == t_current && t_inCycle && size <= g_maxArenaAlloc) {
+        // Letzte Allokation im aktuellen Block (typisch: wachsender sds Buffer) -> in place vergrößern
+        char* end = static_cast<char*>(ptr) + alignUp(h->size);
+        const size_t grow = size > h->size ? alignUp(size) - alignUp(h->size) : 0;
+        if (end == t_current->data() + t_current->used && t_current->used + grow <= t_current->capacity) {
+            t_current->used += grow;
+            t_cycleBytes += grow;
+            if (size > h->size) h->size = size;
+            return ptr;
+        }
+    }
+    if (!h->block && (!t_inCycle || size > g_maxArenaAlloc)) {
+        // Heap bleibt Heap (z.B. wachsende sds Buffer außerhalb eines Zyklus, große Replies)
+        auto* nh = static_cast<Header*>(std::realloc(h, sizeof(Header) + size));
+        if (!nh) return nullptr;
+        nh->size = size;
+        return nh + 1;
+    }
+    void* p = arenaMalloc(size);
+    if (!p) return nullptr;
+    std::memcpy(p, ptr, h->size < size ? h->size : size);
+    arenaFree(ptr);
+    return p;
+}
+
+char* arenaStrdup(const char* s) {
+    const size_t len = std::strlen(s) + 1;
+    auto* p = static_cast<char*>(arenaMalloc(len));
+    if (p) std::memcpy(p, s, len);
+    return p;
+}
+
+} // namespace
+
+bool HiredisArena::install(size_t blockSize, size_t maxArenaAlloc) {
+#if defined(REDIS_STUB)
+    Q_UNUSED(blockSize); Q_UNUSED(maxArenaAlloc);
+    return false;
+#else
+    if (g_installed) return true;
+    g_blockSize = blockSize;
+    g_maxArenaAlloc = maxArenaAlloc < blockSize / 2 ? maxArenaAlloc : blockSize / 2;
+    hiredisAllocFuncs fns = { arenaMalloc, arenaCalloc, arenaRealloc, arenaStrdup, arenaFree };
+    hiredisSetAllocators(&fns);
+    g_installed = true;
+    return true;
+#endif
+}
+
+bool HiredisArena::isInstalled() { return g_installed; }
+
+HiredisArena::Cycle::Cycle() {
+    if (!g_installed || t_inCycle) return;
+    m_active = true;
+    t_inCycle = true;
+    t_cycleBytes = 0;
+    t_cycleAllocs = 0;
+    t_cycleFallbacks = 0;
+}
+
+void HiredisArena::Cycle::finish() {
+    if (!m_active) return;
+    m_active = false;
+    t_inCycle = false;
+    if (t_current) {
+        if (t_current->refs.load(std::memory_order_acquire) == 1) {
+            t_current->used = 0; // nichts überlebt -> Block für den nächsten Zyklus zurücksetzen
+        } else {
+            releaseRef(t_current); // Überlebende halten ihn; neuer Block beim nächsten Bedarf
+            t_current = nullptr;
+        }
+    }
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    ++g_stats.cycles;
+    g_stats.lastCycleBytes = t_cycleBytes;
+    if (t_cycleBytes > g_stats.peakCycleBytes) g_stats.peakCycleBytes = t_cycleBytes;
+    g_totalCycleBytes += static_cast<double>(t_cycleBytes);
+    g_stats.avgCycleBytes = g_totalCycleBytes / static_cast<double>(g_stats.cycles);
+    g_stats.arenaAllocs += t_cycleAllocs;
+    g_stats.heapFallbacks += t_cycleFallbacks;
+}
+
+HiredisArena::Stats HiredisArena::stats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    Stats s = g_stats;
+    s.liveBlocks = g_liveBlocks.load(std::memory_order_relaxed);
+    return s;
+}
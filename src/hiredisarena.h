@@ -0,0 +1,40 @@
+#pragma once
+#include <QtGlobal>
+#include <cstddef>
+
+// Arena Allocator für hiredis (alloc.h / hiredisSetAllocators).
+// Innerhalb eines Poll-Zyklus (HiredisArena::Cycle) werden kleine hiredis Allokationen (redisReply, Reader-Tasks,
+// sds Kommando-/Lesepuffer) per Pointer-Bump aus einem Block bedient. Jede Allokation trägt einen Header mit dem
+// Block, freie Blöcke werden am Zyklusende wiederverwendet. Objekte, die den Zyklus überleben (z.B. Reader-Buffer),
+// halten ihren Block bis zum letzten free am Leben. Außerhalb eines Zyklus, für andere Threads und für Allokationen
+// > maxArenaAlloc wird der Heap benutzt.
+class HiredisArena {
+public:
+    // Muss vor der ersten hiredis Allokation aufgerufen werden (früh in main)
+    static bool install(size_t blockSize = 256 * 1024, size_t maxArenaAlloc = 64 * 1024);
+    static bool isInstalled();
+
+    // RAII Fenster eines Poll-Zyklus (nur im aufrufenden Thread wirksam, nicht verschachteln)
+    class Cycle {
+    public:
+        Cycle();
+        ~Cycle() { finish(); }
+        Cycle(const Cycle&) = delete;
+        Cycle& operator=(const Cycle&) = delete;
+        // Zyklus vorzeitig beenden (idempotent), z.B. bevor Statistik gelesen wird
+        void finish();
+    private:
+        bool m_active {false};
+    };
+
+    struct Stats {
+        quint64 cycles = 0;
+        size_t lastCycleBytes = 0;   // in der Arena bediente Bytes im letzten Zyklus
+        size_t peakCycleBytes = 0;
+        double avgCycleBytes = 0.0;
+        quint64 arenaAllocs = 0;
+        quint64 heapFallbacks = 0;   // zu groß für die Arena (während eines Zyklus)
+        size_t liveBlocks = 0;       // aktuell belegte Blöcke (inkl. aktueller/gecachter)
+    };
+    static Stats stats();
+};
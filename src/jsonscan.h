@@ -0,0 +1,198 @@
+#pragma once
+// Gemeinsame JSON Primitive für die Single-Pass Parser (MarketJsonScanner, RecordDecoder): Whitespace, Strings,
+// Werte überspringen, Zahlen. SSE2/AVX2 zur Compile-Zeit (AVX2 nur mit -mavx2 bzw. MARKET_SCAN_AVX2), sonst skalar.
+// Alle Funktionen arbeiten auf [p, end) und schieben p hinter das Gelesene; false = ungültig / abgeschnitten.
+#include <QByteArray>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define MARKET_SCAN_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MARKET_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace JsonScan {
+
+#if defined(MARKET_SCAN_SSE2) || defined(MARKET_SCAN_AVX2)
+inline int lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+inline bool isWs(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline const char* skipWs(const char* p, const char* end) {
+    while (p < end && isWs(*p)) ++p;
+    return p;
+}
+
+// Erstes '"' oder '\\' ab p, end wenn keins
+inline const char* findQuoteOrEscape(const char* p, const char* end) {
+#if defined(MARKET_SCAN_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i escape32 = _mm256_set1_epi8('\\');
+    for (; end - p >= 32; p += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote32), _mm256_cmpeq_epi8(v, escape32))));
+        if (m) return p + lowestBit(m);
+    }
+#endif
+#if defined(MARKET_SCAN_SSE2)
+    const __m128i quote16 = _mm_set1_epi8('"');
+    const __m128i escape16 = _mm_set1_epi8('\\');
+    for (; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote16), _mm_cmpeq_epi8(v, escape16))));
+        if (m) return p + lowestBit(m);
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == '"' || *p == '\\') return p;
+    }
+    return end;
+}
+
+// Nächstes Strukturzeichen für verschachtelte Werte: '"' '{' '}' '[' ']'
+inline const char* findNested(const char* p, const char* end) {
+#if defined(MARKET_SCAN_AVX2)
+    // '{' '}' und '[' ']' unterscheiden sich nur in Bit 1 -> mit 0xFD maskiert je ein Vergleich
+    const __m256i fold32 = _mm256_set1_epi8(static_cast<char>(0xFD));
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i brace32 = _mm256_set1_epi8('{' & 0xFD);
+    const __m256i bracket32 = _mm256_set1_epi8('[' & 0xFD);
+    for (; end - p >= 32; p += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i f = _mm256_and_si256(v, fold32);
+        const __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote32),
+                                            _mm256_or_si256(_mm256_cmpeq_epi8(f, brace32), _mm256_cmpeq_epi8(f, bracket32)));
+        const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        if (m) return p + lowestBit(m);
+    }
+#endif
+#if defined(MARKET_SCAN_SSE2)
+    const __m128i fold16 = _mm_set1_epi8(static_cast<char>(0xFD));
+    const __m128i quote16 = _mm_set1_epi8('"');
+    const __m128i brace16 = _mm_set1_epi8('{' & 0xFD);
+    const __m128i bracket16 = _mm_set1_epi8('[' & 0xFD);
+    for (; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i f = _mm_and_si128(v, fold16);
+        const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, quote16),
+                                         _mm_or_si128(_mm_cmpeq_epi8(f, brace16), _mm_cmpeq_epi8(f, bracket16)));
+        const uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if (m) return p + lowestBit(m);
+    }
+#endif
+    for (; p < end; ++p) {
+        const char c = *p;
+        if (c == '"' || c == '{' || c == '}' || c == '[' || c == ']') return p;
+    }
+    return end;
+}
+
+// p auf dem öffnenden '"'; danach hinter dem schließenden
+inline bool skipString(const char*& p, const char* end) {
+    ++p;
+    for (;;) {
+        p = findQuoteOrEscape(p, end);
+        if (p == end) return false;
+        if (*p == '"') { ++p; return true; }
+        p += 2; // Escape: nächstes Zeichen gehört dazu (auch '"')
+        if (p > end) return false;
+    }
+}
+
+// Beliebigen JSON Wert überspringen (Inhalt wird nicht validiert, nur die Klammerung)
+inline bool skipValue(const char*& p, const char* end) {
+    if (p == end) return false;
+    if (*p == '"') return skipString(p, end);
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        for (;;) {
+            p = findNested(p, end);
+            if (p == end) return false;
+            const char c = *p;
+            if (c == '"') {
+                if (!skipString(p, end)) return false;
+                continue;
+            }
+            ++p;
+            if (c == '{' || c == '[') ++depth;
+            else if (--depth == 0) return true;
+        }
+    }
+    // Zahl / true / false / null
+    const char* start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && !isWs(*p)) ++p;
+    return p != start;
+}
+
+// JSON Zahl; exakt über den Clinger Fast-Path (<= 2^53 Mantisse, |exp| <= 22), sonst Qt (locale-unabhängig)
+inline bool parseNumber(const char*& p, const char* end, double& out) {
+    static constexpr double kPow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    const char* start = p;
+    const bool negative = (p < end && *p == '-');
+    if (negative) ++p;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+    bool truncated = false;
+    if (p == end || !isDigit(*p)) return false;
+    if (*p == '0') {
+        ++p;
+    } else {
+        for (; p < end && isDigit(*p); ++p) {
+            if (digits < 19) { mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0'); ++digits; }
+            else { ++exp10; truncated |= (*p != '0'); }
+        }
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        if (p == end || !isDigit(*p)) return false;
+        for (; p < end && isDigit(*p); ++p) {
+            const int d = *p - '0';
+            if (mantissa == 0 && d == 0) { --exp10; continue; } // führende Nullen zählen nicht als Stellen
+            if (digits < 19) { mantissa = mantissa * 10 + static_cast<uint64_t>(d); ++digits; --exp10; }
+            else truncated |= (d != 0);
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool expNegative = false;
+        if (p < end && (*p == '+' || *p == '-')) { expNegative = (*p == '-'); ++p; }
+        if (p == end || !isDigit(*p)) return false;
+        int e = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            if (e < 10000) e = e * 10 + (*p - '0');
+        }
+        exp10 += expNegative ? -e : e;
+    }
+    if (!truncated && mantissa <= (uint64_t(1) << 53) && exp10 >= -22 && exp10 <= 22) {
+        double v = static_cast<double>(mantissa);
+        v = exp10 < 0 ? v / kPow10[-exp10] : v * kPow10[exp10];
+        out = negative ? -v : v;
+        return true;
+    }
+    bool ok = false;
+    out = QByteArray::fromRawData(start, static_cast<int>(p - start)).toDouble(&ok);
+    return ok;
+}
+
+} // namespace JsonScan
@@ -0,0 +1,34 @@
+// Keyspace Notification Watcher (PSUBSCRIBE __keyspace@<db>__:<pattern>)
+#include "keyspacewatcher.h"
+#include <QDebug>
+
+KeyspaceWatcher::KeyspaceWatcher(const QString& host, int port, int db, const QString& password, QObject* parent)
+    : QObject(parent), m_client(host.toStdString(), port, db, password.toStdString()),
+      m_prefix("__keyspace@" + std::to_string(db) + "__:") {
+    connect(&m_client, &RedisAsyncClient::connected, this, [this]() { emit healthChanged(true); });
+    connect(&m_client, &RedisAsyncClient::disconnected, this, [this]() { emit healthChanged(false); });
+    connect(&m_client, &RedisAsyncClient::errorOccurred, this, [](const QString& msg) {
+        qWarning() << "keyspace redis:" << msg;
+    });
+}
+
+void KeyspaceWatcher::setKeyPatterns(const std::vector<std::string>& patterns) {
+    if (!m_patterns.empty()) m_client.punsubscribe(m_patterns);
+    m_patterns.clear();
+    for (const auto& p : patterns) m_patterns.push_back(m_prefix + p);
+    if (m_patterns.empty()) return;
+    // Payload einer Keyspace Notification ist der Event-Name, der Key steckt im Kanal
+    m_client.psubscribe(m_patterns, [this](const std::string& channel, const std::string& event) {
+        if (channel.compare(0, m_prefix.size(), m_prefix) != 0) return;
+        ++m_eventCount;
+        emit keyChanged(QString::fromStdString(channel.substr(m_prefix.size())), QString::fromStdString(event));
+    });
+}
+
+void KeyspaceWatcher::start() {
+    m_client.connectToServer();
+}
+
+void KeyspaceWatcher::stop() {
+    m_client.disconnectFromServer();
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <string>
+#include <vector>
+#include "redisasyncclient.h"
+
+// Keyspace Notifications (__keyspace@<db>__:<key>) als Invalidierungs-Signal für den DataPoller.
+// Backend muss nichts publishen, nur der Server braucht notify-keyspace-events (mind. "K$g", besser "KA").
+// Eigene Verbindung, da sie dauerhaft im Subscribe-Modus ist.
+class KeyspaceWatcher : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool healthy READ isHealthy NOTIFY healthChanged)
+public:
+    explicit KeyspaceWatcher(const QString& host = "127.0.0.1", int port = 6380, int db = 0, const QString& password = QString(),
+                             QObject* parent = nullptr);
+
+    // Key-Patterns (Glob wie bei PSUBSCRIBE, z.B. "chart_data_*"); vor oder nach start() setzbar
+    void setKeyPatterns(const std::vector<std::string>& patterns);
+    // verbunden und Subscriptions gesendet - ohne Verbindung gehen Events verloren
+    bool isHealthy() const { return m_client.isConnected(); }
+    qint64 eventCount() const { return m_eventCount; }
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    // event = Redis Kommando-Name (set, del, expired, ...)
+    void keyChanged(const QString& key, const QString& event);
+    void healthChanged(bool healthy);
+
+private:
+    RedisAsyncClient m_client;
+    std::string m_prefix; // "__keyspace@<db>__:"
+    std::vector<std::string> m_patterns;
+    qint64 m_eventCount {0};
+};
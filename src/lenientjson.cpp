@@ -0,0 +1,284 @@
+// Toleranter JSON / Python-Literal Parser (siehe lenientjson.h)
+#include "lenientjson.h"
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+class Parser {
+public:
+    Parser(const char* data, int size) : m_begin(data), m_p(data), m_end(data + size) {}
+
+    bool parseDocument(QJsonValue& out) {
+        skipWs();
+        if (!parseValue(out, 0)) return false;
+        skipWs();
+        if (m_p != m_end) return fail(QJsonParseError::GarbageAtEnd);
+        return true;
+    }
+
+    QJsonParseError::ParseError error() const { return m_error; }
+    int offset() const { return static_cast<int>(m_p - m_begin); }
+
+private:
+    static constexpr int kMaxDepth = 256;
+    const char* m_begin;
+    const char* m_p;
+    const char* m_end;
+    QJsonParseError::ParseError m_error {QJsonParseError::NoError};
+    QByteArray m_scratch; // Puffer für Strings mit Escapes
+
+    bool fail(QJsonParseError::ParseError e) { m_error = e; return false; }
+
+    void skipWs() {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t')) ++m_p;
+    }
+
+    bool matchWord(const char* word) {
+        const size_t n = std::strlen(word);
+        if (static_cast<size_t>(m_end - m_p) < n || std::memcmp(m_p, word, n) != 0) return false;
+        // kein Teil eines längeren Bezeichners (z.B. "Nonesuch")
+        if (m_p + n < m_end) {
+            const char c = m_p[n];
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_') return false;
+        }
+        m_p += n;
+        return true;
+    }
+
+    bool parseValue(QJsonValue& out, int depth) {
+        if (m_p == m_end) return fail(QJsonParseError::IllegalValue);
+        switch (*m_p) {
+            case '{': return parseObject(out, depth);
+            case '[': return parseArray(out, depth, ']');
+            case '(': return parseArray(out, depth, ')');
+            case '"':
+            case '\'': {
+                QString s;
+                if (!parseString(s)) return false;
+                out = QJsonValue(s);
+                return true;
+            }
+            default: break;
+        }
+        if (matchWord("true") || matchWord("True")) { out = QJsonValue(true); return true; }
+        if (matchWord("false") || matchWord("False")) { out = QJsonValue(false); return true; }
+        if (matchWord("null") || matchWord("None")) { out = QJsonValue(QJsonValue::Null); return true; }
+        if (matchWord("nan") || matchWord("NaN")) { out = QJsonValue(std::numeric_limits<double>::quiet_NaN()); return true; }
+        if (matchWord("inf") || matchWord("Infinity")) { out = QJsonValue(std::numeric_limits<double>::infinity()); return true; }
+        return parseNumber(out);
+    }
+
+    bool parseObject(QJsonValue& out, int depth) {
+        if (depth >= kMaxDepth) return fail(QJsonParseError::DeepNesting);
+        ++m_p;
+        QJsonObject obj;
+        skipWs();
+        while (m_p < m_end && *m_p != '}') {
+            QString key;
+            if (*m_p != '"' && *m_p != '\'') return fail(QJsonParseError::IllegalValue);
+            if (!parseString(key)) return false;
+            skipWs();
+            if (m_p == m_end || *m_p != ':') return fail(QJsonParseError::MissingNameSeparator);
+            ++m_p;
+            skipWs();
+            QJsonValue value;
+            if (!parseValue(value, depth + 1)) return false;
+            obj.insert(key, value);
+            skipWs();
+            if (m_p < m_end && *m_p == ',') { ++m_p; skipWs(); continue; }
+            if (m_p < m_end && *m_p == '}') break;
+            return fail(QJsonParseError::MissingValueSeparator);
+        }
+        if (m_p == m_end) return fail(QJsonParseError::UnterminatedObject);
+        ++m_p;
+        out = QJsonValue(obj);
+        return true;
+    }
+
+    bool parseArray(QJsonValue& out, int depth, char close) {
+        if (depth >= kMaxDepth) return fail(QJsonParseError::DeepNesting);
+        ++m_p;
+        QJsonArray arr;
+        skipWs();
+        while (m_p < m_end && *m_p != close) {
+            QJsonValue value;
+            if (!parseValue(value, depth + 1)) return false;
+            arr.append(value);
+            skipWs();
+            if (m_p < m_end && *m_p == ',') { ++m_p; skipWs(); continue; }
+            if (m_p < m_end && *m_p == close) break;
+            return fail(QJsonParseError::MissingValueSeparator);
+        }
+        if (m_p == m_end) return fail(QJsonParseError::UnterminatedArray);
+        ++m_p;
+        out = QJsonValue(arr);
+        return true;
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool readHex(int digits, uint& out) {
+        if (m_end - m_p < digits) return false;
+        out = 0;
+        for (int i = 0; i < digits; ++i) {
+            const int h = hexValue(m_p[i]);
+            if (h < 0) return false;
+            out = (out << 4) | uint(h);
+        }
+        m_p += digits;
+        return true;
+    }
+
+    void appendUtf8(uint cp) {
+        if (cp < 0x80) {
+            m_scratch.append(char(cp));
+        } else if (cp < 0x800) {
+            m_scratch.append(char(0xC0 | (cp >> 6)));
+            m_scratch.append(char(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            m_scratch.append(char(0xE0 | (cp >> 12)));
+            m_scratch.append(char(0x80 | ((cp >> 6) & 0x3F)));
+            m_scratch.append(char(0x80 | (cp & 0x3F)));
+        } else {
+            m_scratch.append(char(0xF0 | (cp >> 18)));
+            m_scratch.append(char(0x80 | ((cp >> 12) & 0x3F)));
+            m_scratch.append(char(0x80 | ((cp >> 6) & 0x3F)));
+            m_scratch.append(char(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    // m_p auf dem öffnenden Quote (' oder "); Escapes nach JSON und Python (\xNN, \UNNNNNNNN, \')
+    bool parseString(QString& out) {
+        const char quote = *m_p++;
+        const char* start = m_p;
+        while (m_p < m_end && *m_p != quote && *m_p != '\\') ++m_p;
+        if (m_p == m_end) return fail(QJsonParseError::UnterminatedString);
+        if (*m_p == quote) { // häufigster Fall: keine Escapes, direkt aus dem Original
+            out = QString::fromUtf8(start, static_cast<int>(m_p - start));
+            ++m_p;
+            return true;
+        }
+        m_scratch.clear();
+        m_scratch.append(start, static_cast<int>(m_p - start));
+        while (m_p < m_end && *m_p != quote) {
+            if (*m_p != '\\') { m_scratch.append(*m_p++); continue; }
+            if (++m_p == m_end) break;
+            const char e = *m_p++;
+            uint cp = 0;
+            switch (e) {
+                case 'n': m_scratch.append('\n'); break;
+                case 't': m_scratch.append('\t'); break;
+                case 'r': m_scratch.append('\r'); break;
+                case 'b': m_scratch.append('\b'); break;
+                case 'f': m_scratch.append('\f'); break;
+                case '0': m_scratch.append('\0'); break;
+                case 'x':
+                    if (!readHex(2, cp)) return fail(QJsonParseError::IllegalEscapeSequence);
+                    appendUtf8(cp);
+                    break;
+                case 'u':
+                    if (!readHex(4, cp)) return fail(QJsonParseError::IllegalEscapeSequence);
+                    // Surrogatpaar (JSON Kodierung von Zeichen > U+FFFF)
+                    if (cp >= 0xD800 && cp < 0xDC00 && m_end - m_p >= 6 && m_p[0] == '\\' && m_p[1] == 'u') {
+                        uint low = 0;
+                        m_p += 2;
+                        if (!readHex(4, low) || low < 0xDC00 || low > 0xDFFF) return fail(QJsonParseError::IllegalEscapeSequence);
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(cp);
+                    break;
+                case 'U':
+                    if (!readHex(8, cp) || cp > 0x10FFFF) return fail(QJsonParseError::IllegalEscapeSequence);
+                    appendUtf8(cp);
+                    break;
+                default: // \" \' \\ \/ und unbekannte Escapes: Zeichen übernehmen
+                    m_scratch.append(e);
+                    break;
+            }
+        }
+        if (m_p == m_end) return fail(QJsonParseError::UnterminatedString);
+        ++m_p;
+        out = QString::fromUtf8(m_scratch);
+        return true;
+    }
+
+    bool parseNumber(QJsonValue& out) {
+        const char* start = m_p;
+        if (m_p < m_end && (*m_p == '-' || *m_p == '+')) ++m_p;
+        if (matchWord("inf") || matchWord("Infinity")) {
+            const double inf = std::numeric_limits<double>::infinity();
+            out = QJsonValue(*start == '-' ? -inf : inf);
+            return true;
+        }
+        bool integral = true;
+        const char* digits = m_p;
+        while (m_p < m_end) {
+            const char c = *m_p;
+            if (c >= '0' && c <= '9') { ++m_p; continue; }
+            if (c == '.' || c == 'e' || c == 'E' || ((c == '-' || c == '+') && (m_p[-1] == 'e' || m_p[-1] == 'E'))) {
+                integral = false;
+                ++m_p;
+                continue;
+            }
+            break;
+        }
+        if (m_p == digits) return fail(QJsonParseError::IllegalValue);
+        const QByteArray token = QByteArray::fromRawData(start, static_cast<int>(m_p - start));
+        bool ok = false;
+        if (integral) {
+            const qint64 v = token.toLongLong(&ok);
+            if (ok) { out = QJsonValue(v); return true; }
+        }
+        const double d = token.toDouble(&ok);
+        if (!ok) return fail(QJsonParseError::IllegalNumber);
+        out = QJsonValue(d);
+        return true;
+    }
+};
+
+// Python repr erkennt man am ersten Key/String: repr() nimmt ' solange der Text kein ' enthält
+bool looksLikePython(const QByteArray& bytes) {
+    const char* p = bytes.constData();
+    const char* end = p + bytes.size();
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t' || *p == '{' || *p == '[' || *p == '(')) ++p;
+    return p < end && *p == '\'';
+}
+
+} // namespace
+
+QJsonDocument LenientJson::parse(const QByteArray& bytes, QJsonParseError* error) {
+    if (!looksLikePython(bytes)) {
+        QJsonParseError err {};
+        QJsonDocument doc = QJsonDocument::fromJson(bytes, &err);
+        if (err.error == QJsonParseError::NoError) {
+            if (error) *error = err;
+            return doc;
+        }
+    }
+    return parseLenient(bytes, error);
+}
+
+QJsonDocument LenientJson::parseLenient(const QByteArray& bytes, QJsonParseError* error) {
+    Parser parser(bytes.constData(), static_cast<int>(bytes.size()));
+    QJsonValue root;
+    const bool ok = parser.parseDocument(root);
+    if (error) {
+        error->error = ok ? QJsonParseError::NoError : parser.error();
+        error->offset = ok ? 0 : parser.offset();
+    }
+    if (!ok) return {};
+    if (root.isObject()) return QJsonDocument(root.toObject());
+    if (root.isArray()) return QJsonDocument(root.toArray());
+    if (error) { error->error = QJsonParseError::IllegalValue; error->offset = 0; }
+    return {}; // Skalar auf oberster Ebene: wie QJsonDocument nicht darstellbar
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+// JSON Decoder der zusätzlich Python-Literal Syntax (repr / str(dict)) versteht: Strings in '...' oder "...",
+// True/False/None, Tupel (...) als Array, nan/inf, Komma vor schließender Klammer. Ein Durchgang direkt über die
+// Originalbytes, kein Quote-Replace: Apostrophe in Werten ("O'Neil", 'it\'s') bleiben erhalten.
+// Gültiges JSON geht zuerst an QJsonDocument::fromJson (schneller); nur wenn das scheitert oder der Wert sichtbar
+// Python-Syntax ist, übernimmt der eigene Parser.
+class LenientJson {
+public:
+    static QJsonDocument parse(const QByteArray& bytes, QJsonParseError* error = nullptr);
+    // Nur der tolerante Parser (ohne QJsonDocument Versuch)
+    static QJsonDocument parseLenient(const QByteArray& bytes, QJsonParseError* error = nullptr);
+};
@@ -16,6 +16,11 @@
 #include "notificationsmodel.h"
 #include "chartdatamodel.h"
 #include "predictionsmodel.h"
+#include "redispubsubclient.h"
+#include "keyspacewatcher.h"
+#include "hiredisarena.h"
+#include "marketstreamconsumer.h"
+#include "rediswritequeue.h"
 
 int main(int argc, char *argv[]) {
     QGuiApplication app(argc, argv);
@@ -26,21 +31,84 @@ int main(int argc, char *argv[]) {
     QCommandLineParser parser;
     parser.setApplicationDescription("QtTrade Frontend");
     parser.addHelpOption();
-    QCommandLineOption hostOpt({"r","redis-host"}, "Redis Host", "host", "127.0.0.1");
+    QCommandLineOption hostOpt({"r","redis-host"}, "Redis Host (or unix:/path/to/redis.sock)", "host", "127.0.0.1");
     QCommandLineOption portOpt({"p","redis-port"}, "Redis Port", "port", "6380");
     QCommandLineOption passOpt({"w","redis-password"}, "Redis Password", "password", "");
+    QCommandLineOption noDelayOpt({"N","tcp-nodelay"}, "TCP_NODELAY on the polling connection (1/0)", "on", "1");
+    QCommandLineOption keepAliveOpt({"k","tcp-keepalive"}, "TCP keepalive interval in seconds (0 = off)", "seconds", "0");
+    QCommandLineOption rcvBufOpt({"B","tcp-rcvbuf"}, "Socket receive buffer in bytes (0 = OS default)", "bytes", "0");
+    QCommandLineOption masterHostOpt("master-host", "Remote master used for reads while the replica lags (empty = off)", "host", "");
+    QCommandLineOption masterPortOpt("master-port", "Remote master port", "port", "6380");
+    QCommandLineOption masterPassOpt("master-password", "Remote master password", "password", "");
+    QCommandLineOption maxLagOpt("max-lag", "Replica lag threshold in seconds (master_last_io_seconds_ago)", "seconds", "15");
+    QCommandLineOption maxLagBytesOpt("max-lag-bytes", "Replica lag threshold in bytes (0 = ignore offsets)", "bytes", "0");
+    QCommandLineOption shardOpt("shard", "Redis shard for chart/predictions keys (host:port, repeatable; consistent hashing by symbol)", "endpoint");
     QCommandLineOption perfOpt({"L","perf-log"}, "Enable performance logging (poll latency)");
+    QCommandLineOption pipelineOpt({"P","pipeline"}, "Pipelined polling (PING + all GETs in one round trip)");
+    QCommandLineOption asyncOpt({"A","async"}, "Non-blocking Redis I/O on the Qt event loop (hiredis async)");
+    QCommandLineOption decodeThreadOpt("decode-thread", "Fetch and decode on a worker thread; the GUI thread only applies decoded snapshots");
+    QCommandLineOption pubsubOpt({"S","pubsub"}, "Real-time updates via Redis Pub/Sub (polling drops to a slow consistency sweep)");
+    QCommandLineOption keyspaceOpt({"K","keyspace"}, "Fetch only keys changed according to keyspace notifications");
+    QCommandLineOption digestOpt({"D","digest"}, "Server-side digest check (Lua), fetch only keys whose content changed");
+    QCommandLineOption trackingOpt({"T","tracking"}, "RESP3 client-side caching (CLIENT TRACKING) for synchronous polling");
+    QCommandLineOption streamOpt({"X","stream"}, "Incremental market ticks from the market_ticks stream (XREAD BLOCK)");
+    QCommandLineOption arenaOpt({"M","arena"}, "Per-poll arena allocator for hiredis (alloc.h)");
+    QCommandLineOption marketHashOpt({"H","market-hash"}, "Market data as market:<SYM> hashes, delta fetch via market:index + HMGET");
+    QCommandLineOption chartFormatOpt({"C","chart-format"}, "Candle source: json (chart_data_<SYM>), bin (chart_bin_<SYM>) or zset (chart_zset:<SYM>, incremental)", "format", "json");
     parser.addOption(hostOpt);
     parser.addOption(portOpt);
     parser.addOption(passOpt);
+    parser.addOption(noDelayOpt);
+    parser.addOption(keepAliveOpt);
+    parser.addOption(rcvBufOpt);
+    parser.addOption(masterHostOpt);
+    parser.addOption(masterPortOpt);
+    parser.addOption(masterPassOpt);
+    parser.addOption(maxLagOpt);
+    parser.addOption(maxLagBytesOpt);
+    parser.addOption(shardOpt);
     parser.addOption(perfOpt);
+    parser.addOption(pipelineOpt);
+    parser.addOption(asyncOpt);
+    parser.addOption(decodeThreadOpt);
+    parser.addOption(pubsubOpt);
+    parser.addOption(keyspaceOpt);
+    parser.addOption(digestOpt);
+    parser.addOption(trackingOpt);
+    parser.addOption(streamOpt);
+    parser.addOption(arenaOpt);
+    parser.addOption(marketHashOpt);
+    parser.addOption(chartFormatOpt);
     parser.process(app);
 
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     QString host = env.value("REDIS_HOST", parser.value(hostOpt));
     int port = env.value("REDIS_PORT", parser.value(portOpt)).toInt();
     QString password = env.value("REDIS_PASSWORD", parser.value(passOpt));
+    RedisClient::SocketOptions socketOptions;
+    socketOptions.tcpNoDelay = env.value("REDIS_TCP_NODELAY", parser.value(noDelayOpt)) != "0";
+    socketOptions.keepAliveSec = env.value("REDIS_TCP_KEEPALIVE", parser.value(keepAliveOpt)).toInt();
+    socketOptions.recvBufferBytes = env.value("REDIS_TCP_RCVBUF", parser.value(rcvBufOpt)).toInt();
+    QString masterHost = env.value("REDIS_MASTER_HOST", parser.value(masterHostOpt));
+    int masterPort = env.value("REDIS_MASTER_PORT", parser.value(masterPortOpt)).toInt();
+    QString masterPassword = env.value("REDIS_MASTER_PASSWORD", parser.value(masterPassOpt));
+    int maxLagSeconds = env.value("REDIS_MAX_LAG_S", parser.value(maxLagOpt)).toInt();
+    qint64 maxLagBytes = env.value("REDIS_MAX_LAG_BYTES", parser.value(maxLagBytesOpt)).toLongLong();
+    QStringList shards = env.contains("REDIS_SHARDS") ? env.value("REDIS_SHARDS").split(',', Qt::SkipEmptyParts) : parser.values(shardOpt);
     bool perfLogging = env.value("PERF_LOG", parser.isSet(perfOpt)?"1":"0") == "1";
+    bool pipelined = env.value("REDIS_PIPELINE", parser.isSet(pipelineOpt)?"1":"0") == "1";
+    bool asyncIo = env.value("REDIS_ASYNC", parser.isSet(asyncOpt)?"1":"0") == "1";
+    bool decodeThread = env.value("REDIS_DECODE_THREAD", parser.isSet(decodeThreadOpt)?"1":"0") == "1";
+    bool pubsub = env.value("REDIS_PUBSUB", parser.isSet(pubsubOpt)?"1":"0") == "1";
+    bool keyspace = env.value("REDIS_KEYSPACE", parser.isSet(keyspaceOpt)?"1":"0") == "1";
+    bool digest = env.value("REDIS_DIGEST", parser.isSet(digestOpt)?"1":"0") == "1";
+    bool tracking = env.value("REDIS_TRACKING", parser.isSet(trackingOpt)?"1":"0") == "1";
+    bool marketStream = env.value("REDIS_STREAM", parser.isSet(streamOpt)?"1":"0") == "1";
+    bool arena = env.value("REDIS_ARENA", parser.isSet(arenaOpt)?"1":"0") == "1";
+    bool marketHash = env.value("REDIS_MARKET_HASH", parser.isSet(marketHashOpt)?"1":"0") == "1";
+    const QString chartFormat = env.value("REDIS_CHART_FORMAT", parser.value(chartFormatOpt));
+    // vor der ersten hiredis Allokation installieren
+    if (arena && !HiredisArena::install()) qWarning() << "hiredis arena allocator not available (stub build)";
 
     // Redis Models reaktiviert für echte Daten
     MarketModel marketModel;
@@ -56,6 +124,40 @@ int main(int argc, char *argv[]) {
     poller.setChartModel(&chartDataModel);
     poller.setPredictionsModel(&predictionsModel);
     poller.setPerformanceLogging(perfLogging);
+    poller.setPipelinedPolling(pipelined);
+    poller.setSocketOptions(socketOptions);
+    poller.setShards(shards);
+    if (!masterHost.isEmpty()) poller.setMasterEndpoint(masterHost, masterPort, masterPassword, maxLagSeconds, maxLagBytes);
+    poller.setClientTracking(tracking);
+    poller.setDigestPolling(digest);
+    poller.setHashMarketLayout(marketHash);
+    poller.setChartFormat(chartFormat == "bin" ? DataPoller::ChartFormat::Binary
+                          : chartFormat == "zset" ? DataPoller::ChartFormat::SortedSet : DataPoller::ChartFormat::Json);
+    poller.setAsyncMode(asyncIo);
+    poller.setDecodeThread(decodeThread);
+
+    RedisPubSubClient pubSubClient(host, port, password);
+    if (pubsub) {
+        pubSubClient.setMarketModel(&marketModel);
+        pubSubClient.setChartModel(&chartDataModel);
+        pubSubClient.setPredictionsModel(&predictionsModel);
+        poller.setPubSubClient(&pubSubClient);
+        pubSubClient.start();
+    }
+    MarketStreamConsumer marketStreamConsumer(&marketModel, host, port, password);
+    if (marketStream) {
+        poller.setMarketStreamConsumer(&marketStreamConsumer);
+        marketStreamConsumer.start();
+    }
+    KeyspaceWatcher keyspaceWatcher(host, port, 0, password);
+    if (keyspace) {
+        poller.setKeyspaceWatcher(&keyspaceWatcher);
+        keyspaceWatcher.start();
+    }
+    // Writes (manual_trigger_*, *_schedule, alpaca_mode) müssen auf eine schreibbare Instanz: die Replica ist read-only
+    RedisWriteQueue writeQueue(masterHost.isEmpty() ? host : masterHost, masterHost.isEmpty() ? port : masterPort,
+                               masterHost.isEmpty() ? password : masterPassword);
+    writeQueue.start();
     poller.start();
 
     QQmlApplicationEngine engine;
@@ -68,6 +170,7 @@ int main(int argc, char *argv[]) {
     engine.rootContext()->setContextProperty("chartDataModel", &chartDataModel);
     engine.rootContext()->setContextProperty("predictionsModel", &predictionsModel);
     engine.rootContext()->setContextProperty("poller", &poller); 
+    engine.rootContext()->setContextProperty("writeQueue", &writeQueue);
 
     // QML Logging für Diagnose
     qInstallMessageHandler([](QtMsgType type, const QMessageLogContext &ctx, const QString &msg){
@@ -0,0 +1,96 @@
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+#include "marketjsonscanner.h"
+
+// Vergleicht den market_data Parse-Pfad: QJsonDocument DOM (wie MarketModel::updateFromMap) gegen MarketJsonScanner.
+// Nutzung: market_json_bench [symbole=5000] [runden=200]; Exit-Code 1 wenn der Scanner nicht mindestens 5x schneller ist.
+namespace {
+QByteArray makeSnapshot(int symbols) {
+    QByteArray json("{");
+    for (int i = 0; i < symbols; ++i) {
+        if (i) json += ",\n";
+        const double price = 10.0 + (i * 37 % 50000) / 100.0;
+        const double change = ((i * 13) % 400 - 200) / 100.0;
+        json += "\"S" + QByteArray::number(i) + "\": {\"price\": " + QByteArray::number(price, 'f', 2)
+              + ", \"change\": " + QByteArray::number(change, 'f', 2)
+              + ", \"change_percent\": " + QByteArray::number(change / price * 100.0, 'f', 4) + "}";
+    }
+    json += "}";
+    return json;
+}
+
+struct Fields {
+    double price, change, changePercent;
+    bool operator==(const Fields& o) const {
+        return price == o.price && change == o.change && changePercent == o.changePercent;
+    }
+};
+using FieldsBySymbol = std::unordered_map<std::string, Fields>;
+
+// Je Symbol exakt vergleichen: beide Pfade müssen aus denselben Ziffern dasselbe double lesen
+// (Summen wären reihenfolgeabhängig, DOM iteriert sortiert, der Scanner in Dokument-Reihenfolge)
+bool sameQuotes(const FieldsBySymbol& dom, const std::vector<MarketJsonQuote>& scanned) {
+    if (dom.size() != scanned.size()) return false;
+    for (const auto& q : scanned) {
+        const auto it = dom.find(std::string(q.symbol, q.symbolLength));
+        if (it == dom.end() || !(it->second == Fields { q.price, q.change, q.changePercent })) return false;
+    }
+    return true;
+}
+
+template <class F>
+double bestRunUs(int rounds, F&& fn) {
+    double best = 1e300;
+    for (int i = 0; i < rounds; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (us < best) best = us;
+    }
+    return best;
+}
+}
+
+int main(int argc, char** argv) {
+    const int symbols = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+    const QByteArray json = makeSnapshot(symbols);
+
+    // wie quotesFromMap: Symbol + drei Felder je Eintrag in einen Vektor
+    std::vector<std::pair<QString, Fields>> domRows;
+    const double domUs = bestRunUs(rounds, [&]() {
+        domRows.clear();
+        const QJsonObject root = QJsonDocument::fromJson(json).object();
+        for (auto it = root.begin(); it != root.end(); ++it) {
+            const QJsonObject obj = it.value().toObject();
+            domRows.emplace_back(it.key(), Fields { obj.value("price").toDouble(), obj.value("change").toDouble(),
+                                                    obj.value("change_percent").toDouble() });
+        }
+    });
+    FieldsBySymbol domFields;
+    for (const auto& row : domRows) domFields[row.first.toStdString()] = row.second;
+
+    std::vector<MarketJsonQuote> quotes;
+    bool scanOk = true;
+    const double scanUs = bestRunUs(rounds, [&]() {
+        scanOk &= MarketJsonScanner::scan(json.constData(), static_cast<size_t>(json.size()), quotes);
+    });
+
+    if (!scanOk || quotes.size() != static_cast<size_t>(symbols) || !sameQuotes(domFields, quotes)) {
+        std::cerr << "Scanner result differs from QJsonDocument\n";
+        return 2;
+    }
+    const double speedup = domUs / scanUs;
+    std::cout << symbols << " symbols, " << json.size() << " bytes, best of " << rounds << " (" << MarketJsonScanner::simdLevel() << ")\n"
+              << "QJsonDocument: " << domUs << " us, scanner: " << scanUs << " us, speedup: " << speedup << "x\n";
+    return speedup >= 5.0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+// SIMD-gestützter Scanner für market_data (siehe marketjsonscanner.h)
+#include "marketjsonscanner.h"
+#include "jsonscan.h"
+#include <cstring>
+
+namespace {
+
+using namespace JsonScan;
+
+// p auf '{' eines Symbol-Objekts; schreibt bekannte Felder in quote
+bool parseQuote(const char*& p, const char* end, MarketJsonQuote& quote) {
+    p = skipWs(p + 1, end);
+    if (p < end && *p == '}') { ++p; return true; }
+    for (;;) {
+        if (p == end || *p != '"') return false;
+        const char* key = p + 1;
+        const char* keyEnd = findQuoteOrEscape(key, end);
+        if (keyEnd == end) return false;
+        double* field = nullptr;
+        if (*keyEnd == '\\') {
+            if (!skipString(p, end)) return false; // Key mit Escape ist keins unserer Felder
+        } else {
+            const size_t len = static_cast<size_t>(keyEnd - key);
+            if (len == 5 && std::memcmp(key, "price", 5) == 0) field = &quote.price;
+            else if (len == 6 && std::memcmp(key, "change", 6) == 0) field = &quote.change;
+            else if (len == 14 && std::memcmp(key, "change_percent", 14) == 0) field = &quote.changePercent;
+            p = keyEnd + 1;
+        }
+        p = skipWs(p, end);
+        if (p == end || *p != ':') return false;
+        p = skipWs(p + 1, end);
+        if (field && p < end && (*p == '-' || isDigit(*p))) {
+            if (!parseNumber(p, end, *field)) return false;
+        } else if (!skipValue(p, end)) {
+            return false; // Nicht-Zahl bleibt 0 wie QJsonValue::toDouble()
+        }
+        p = skipWs(p, end);
+        if (p == end) return false;
+        if (*p == ',') { p = skipWs(p + 1, end); continue; }
+        if (*p == '}') { ++p; return true; }
+        return false;
+    }
+}
+
+} // namespace
+
+bool MarketJsonScanner::scan(const char* data, size_t size, std::vector<MarketJsonQuote>& out) {
+    out.clear();
+    const char* p = data;
+    const char* end = data + size;
+    if (size >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3; // UTF-8 BOM
+    p = skipWs(p, end);
+    if (p == end || *p != '{') return false;
+    p = skipWs(p + 1, end);
+    if (p < end && *p == '}') return skipWs(p + 1, end) == end;
+    for (;;) {
+        if (p == end || *p != '"') return false;
+        const char* sym = p + 1;
+        const char* symEnd = findQuoteOrEscape(sym, end);
+        if (symEnd == end || *symEnd != '"') return false; // Escape im Symbol -> DOM Pfad
+        p = skipWs(symEnd + 1, end);
+        if (p == end || *p != ':') return false;
+        p = skipWs(p + 1, end);
+        if (p < end && *p == '{') {
+            MarketJsonQuote quote { sym, static_cast<int>(symEnd - sym), 0.0, 0.0, 0.0 };
+            if (!parseQuote(p, end, quote)) return false;
+            out.push_back(quote);
+        } else if (!skipValue(p, end)) {
+            return false; // Nicht-Objekte werden wie in updateFromMap ignoriert
+        }
+        p = skipWs(p, end);
+        if (p == end) return false;
+        if (*p == ',') { p = skipWs(p + 1, end); continue; }
+        if (*p == '}') return skipWs(p + 1, end) == end;
+        return false;
+    }
+}
+
+const char* MarketJsonScanner::simdLevel() {
+#if defined(MARKET_SCAN_AVX2)
+    return "avx2";
+#elif defined(MARKET_SCAN_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Ein Eintrag aus market_data; symbol zeigt in den gescannten Puffer (nur gültig solange dieser lebt)
+struct MarketJsonQuote {
+    const char* symbol;
+    int symbolLength;
+    double price;
+    double change;
+    double changePercent;
+};
+
+// Single-Pass Scanner für genau die market_data Form {"SYM": {"price":..,"change":..,"change_percent":..}, ...}
+// (redis.txt 1). Kein DOM, keine Allokation außer dem Wachstum von out (Kapazität bleibt beim Wiederverwenden).
+// String-Enden und zu überspringende Werte werden per SSE2/AVX2 gesucht (Compile-Zeit Auswahl, sonst skalar).
+// false bei allem, was nicht in diese Form passt (Escapes im Symbol, Python-Dict, kaputtes JSON): Aufrufer
+// nimmt dann den QJsonDocument Pfad. Felder außer price/change/change_percent werden übersprungen, fehlende = 0.
+class MarketJsonScanner {
+public:
+    static bool scan(const char* data, size_t size, std::vector<MarketJsonQuote>& out);
+    // "avx2" | "sse2" | "scalar" (für Benchmark / Perf-Log)
+    static const char* simdLevel();
+};
@@ -1,27 +1,30 @@
 #include "marketmodel.h"
+#include "cborreader.h"
+#include "lenientjson.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QJsonValueRef>
 #include <QDebug>
+#include <algorithm>
 #include <unordered_set>
 
 MarketModel::MarketModel(QObject* parent) : QAbstractListModel(parent) {}
 
 int MarketModel::rowCount(const QModelIndex& parent) const {
     if (parent.isValid()) return 0;
-    return static_cast<int>(m_rows.size());
+    return static_cast<int>(m_symbols.size());
 }
 
 QVariant MarketModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) return {};
-    const auto& r = m_rows[static_cast<size_t>(index.row())];
+    const size_t i = static_cast<size_t>(index.row());
     switch (role) {
-        case SymbolRole: return r.symbol;
-        case PriceRole: return r.price;
-        case ChangeRole: return r.change;
-        case ChangePercentRole: return r.changePercent;
-        case DirectionRole: return r.direction;
+        case SymbolRole: return m_symbols[i];
+        case PriceRole: return m_price[i];
+        case ChangeRole: return m_change[i];
+        case ChangePercentRole: return m_changePct[i];
+        case DirectionRole: return int(m_direction[i]);
         default: return {};
     }
 }
@@ -36,111 +39,263 @@ QHash<int, QByteArray> MarketModel::roleNames() const {
     };
 }
 
+namespace {
+qint8 directionOf(double change) { return change > 0 ? 1 : (change < 0 ? -1 : 0); }
+bool sameSymbol(const QString& row, const MarketJsonQuote& q) { return row == QLatin1String(q.symbol, q.symbolLength); }
+bool sameSymbol(const QString& row, const MarketQuote& q) { return row == q.symbol; }
+QString symbolOf(const MarketJsonQuote& q) { return QString::fromUtf8(q.symbol, q.symbolLength); }
+const QString& symbolOf(const MarketQuote& q) { return q.symbol; }
+} // namespace
+
 void MarketModel::updateFromJson(const QByteArray& jsonBytes) {
-    // Erst versuchen, als JSON zu parsen
-    QJsonParseError err{};
-    auto doc = QJsonDocument::fromJson(jsonBytes, &err);
-    if (err.error == QJsonParseError::NoError && doc.isObject()) {
-        // Erfolgreich als JSON geparst
-        updateFromMap(doc.object());
+    if (!decodeSnapshot(jsonBytes, m_snapshot)) {
+        qDebug() << "MarketModel: Failed to parse data format:" << QString::fromUtf8(jsonBytes.left(100)) << "...";
         return;
     }
-    
-    // Falls JSON-Parsing fehlschlägt, versuche Python-Dict Format zu konvertieren
-    QString dataStr = QString::fromUtf8(jsonBytes);
-    if (dataStr.startsWith("{'") || dataStr.startsWith("{\"")) {
-        // Python-Dict Format: Ersetze Single Quotes mit Double Quotes für JSON
-        QString jsonStr = dataStr;
-        jsonStr.replace("'", "\"");
-        
-        // Versuche nochmal als JSON zu parsen
-        auto docRetry = QJsonDocument::fromJson(jsonStr.toUtf8(), &err);
-        if (err.error == QJsonParseError::NoError && docRetry.isObject()) {
-            updateFromMap(docRetry.object());
-            return;
-        }
+    applySnapshot(m_snapshot);
+    m_snapshot.source = QByteArray(); // Puffer nicht über den Aufruf hinaus festhalten
+}
+
+bool MarketModel::decodeSnapshot(const QByteArray& bytes, MarketSnapshot& out) {
+    out.source = bytes;
+    out.scanned.clear();
+    out.quotes.clear();
+    out.diff.layout.reset();
+    if (CborReader::isCbor(bytes)) return decodeCbor(bytes, out.quotes);
+    // Hot Path: Single-Pass Scanner ohne DOM; nur wenn die Form nicht passt, LenientJson
+    if (MarketJsonScanner::scan(out.source.constData(), static_cast<size_t>(out.source.size()), out.scanned)) return true;
+    out.scanned.clear();
+    // JSON oder Python-Dict (repr) in einem Durchgang über die Originalbytes
+    QJsonParseError err{};
+    auto doc = LenientJson::parse(bytes, &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) return false;
+    quotesFromMap(doc.object(), out.quotes);
+    return true;
+}
+
+std::shared_ptr<const MarketLayout> MarketModel::layout() const {
+    if (!m_layout) {
+        auto layout = std::make_shared<MarketLayout>();
+        layout->generation = m_generation;
+        layout->symbols = m_symbols;
+        layout->index = m_indexMap; // implizit geteilt, keine Kopie der Einträge
+        m_layout = std::move(layout);
     }
-    
-    // Falls beide Versuche fehlschlagen, gib Debug-Info aus
-    qDebug() << "MarketModel: Failed to parse data format:" << dataStr.left(100) << "...";
+    return m_layout;
 }
 
-void MarketModel::updateFromMap(const QJsonObject& rootObj) {
-    // Track seen symbols
-    QSet<QString> seen;
+void MarketModel::diffSnapshot(MarketSnapshot& snapshot, const std::shared_ptr<const MarketLayout>& layout) {
+    if (!snapshot.scanned.empty()) computeDiff(snapshot.scanned, *layout, snapshot.diff);
+    else computeDiff(snapshot.quotes, *layout, snapshot.diff);
+    snapshot.diff.layout = layout;
+}
 
-    // 1. Update existing rows where symbol still present
-    for (auto it = rootObj.begin(); it != rootObj.end(); ++it) {
-        const QString sym = it.key();
-        if (!it.value().isObject()) continue;
-        seen.insert(sym);
-        auto obj = it.value().toObject();
-        double price = obj.value("price").toDouble();
-        double change = obj.value("change").toDouble();
-        double changePct = obj.value("change_percent").toDouble();
-        int direction = change > 0 ? 1 : (change < 0 ? -1 : 0);
-
-        if (m_indexMap.contains(sym)) {
-            int idx = m_indexMap.value(sym);
-            if (idx >= 0 && idx < m_rows.size()) {
-                auto &row = m_rows[static_cast<size_t>(idx)];
-                bool anyChanged = (row.price != price) || (row.change != change) || (row.changePercent != changePct) || (row.direction != direction);
-                if (anyChanged) {
-                    row.price = price;
-                    row.change = change;
-                    row.changePercent = changePct;
-                    row.direction = direction;
-                    QModelIndex qmi = index(idx);
-                    QVector<int> roles { PriceRole, ChangeRole, ChangePercentRole, DirectionRole };
-                    emit dataChanged(qmi, qmi, roles);
-                    emit rowAnimated(idx);
-                }
-            }
-        }
+void MarketModel::applySnapshot(const MarketSnapshot& snapshot) {
+    const MarketDiff* diff = &snapshot.diff;
+    if (!diff->layout || diff->layout->generation != m_generation) {
+        // kein oder veralteter Abgleich (Zeilen inzwischen per applyQuotes eingefügt/entfernt): hier neu rechnen
+        const std::shared_ptr<const MarketLayout> current = layout();
+        if (!snapshot.scanned.empty()) computeDiff(snapshot.scanned, *current, m_diff);
+        else computeDiff(snapshot.quotes, *current, m_diff);
+        diff = &m_diff;
     }
+    if (!snapshot.scanned.empty()) applyDiff(snapshot.scanned, *diff);
+    else applyDiff(snapshot.quotes, *diff);
+}
 
-    // 2. Remove rows not present anymore (iterate backwards for index stability)
-    for (int i = static_cast<int>(m_rows.size()) - 1; i >= 0; --i) {
-        const QString &sym = m_rows[static_cast<size_t>(i)].symbol;
-        if (!seen.contains(sym)) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_rows.erase(m_rows.begin() + i);
-            endRemoveRows();
+template <class Quote> void MarketModel::computeDiff(const std::vector<Quote>& quotes, const MarketLayout& layout, MarketDiff& diff) {
+    const size_t rows = layout.symbols.size();
+    diff.keep.assign(rows, 0);
+    diff.rows.resize(quotes.size());
+    diff.inserted.clear();
+    // Snapshots kommen meist in gleicher Reihenfolge: erst die Zeile nach dem letzten Treffer vergleichen
+    // (ohne QString zu bauen), erst bei Abweichung über den Index suchen
+    size_t hint = 0;
+    for (size_t k = 0; k < quotes.size(); ++k) {
+        const Quote& q = quotes[k];
+        int idx = -1;
+        if (hint < rows && sameSymbol(layout.symbols[hint], q)) {
+            idx = static_cast<int>(hint);
+        } else {
+            auto it = layout.index.constFind(symbolOf(q));
+            if (it != layout.index.constEnd()) idx = it.value();
         }
+        diff.rows[k] = idx;
+        if (idx < 0) {
+            diff.inserted.push_back(MarketQuote { symbolOf(q), q.price, q.change, q.changePercent });
+            continue;
+        }
+        diff.keep[static_cast<size_t>(idx)] = 1;
+        hint = static_cast<size_t>(idx) + 1;
+    }
+    // Zielzeilen nach dem Entfernen: so beziehen sich dataChanged und rowsAnimated auf die endgültigen Zeilen
+    diff.removes = std::find(diff.keep.begin(), diff.keep.end(), 0) != diff.keep.end();
+    if (!diff.removes) return;
+    std::vector<int> remap(rows);
+    int next = 0;
+    for (size_t i = 0; i < rows; ++i) remap[i] = diff.keep[i] ? next++ : -1;
+    for (int& idx : diff.rows) {
+        if (idx >= 0) idx = remap[static_cast<size_t>(idx)];
     }
+}
 
-    // Rebuild index map (after removals, before potential inserts)
-    m_indexMap.clear();
-    for (int i = 0; i < static_cast<int>(m_rows.size()); ++i) {
-        m_indexMap.insert(m_rows[static_cast<size_t>(i)].symbol, i);
+template <class Quote> void MarketModel::applyDiff(const std::vector<Quote>& quotes, const MarketDiff& diff) {
+    // Erst entfernen, dann Werte schreiben, zuletzt neue Zeilen anhängen
+    if (diff.removes) dropRows(diff.keep);
+    for (size_t k = 0; k < quotes.size(); ++k) {
+        if (diff.rows[k] >= 0) updateRow(diff.rows[k], quotes[k].price, quotes[k].change, quotes[k].changePercent);
     }
+    if (!diff.inserted.empty()) stageQuotes(diff.inserted);
+    flushChanges();
+}
 
-    // 3. Insert new symbols (preserve order of JSON iteration for those not existing)
-    QList<MarketRow> toInsert;
+bool MarketModel::decodeCbor(const QByteArray& cborBytes, std::vector<MarketQuote>& quotes) {
+    CborReader r(cborBytes);
+    const bool ok = r.readMap([&](const QString& sym) {
+        MarketQuote q;
+        q.symbol = sym;
+        const bool isQuote = r.readMap([&](const QString& field) {
+            if (field == QLatin1String("price")) q.price = r.readDouble();
+            else if (field == QLatin1String("change")) q.change = r.readDouble();
+            else if (field == QLatin1String("change_percent")) q.changePercent = r.readDouble();
+            else r.skip();
+        });
+        if (isQuote) quotes.push_back(std::move(q));
+    });
+    if (!ok) qDebug() << "MarketModel: Failed to decode CBOR market_data (" << cborBytes.size() << "bytes)";
+    return ok;
+}
+
+void MarketModel::quotesFromMap(const QJsonObject& rootObj, std::vector<MarketQuote>& quotes) {
+    quotes.reserve(static_cast<size_t>(rootObj.size()));
     for (auto it = rootObj.begin(); it != rootObj.end(); ++it) {
-        const QString sym = it.key();
         if (!it.value().isObject()) continue;
-        if (!m_indexMap.contains(sym)) {
-            auto obj = it.value().toObject();
-            MarketRow row;
-            row.symbol = sym;
-            row.price = obj.value("price").toDouble();
-            row.change = obj.value("change").toDouble();
-            row.changePercent = obj.value("change_percent").toDouble();
-            row.direction = row.change > 0 ? 1 : (row.change < 0 ? -1 : 0);
-            toInsert.append(row);
-        }
+        const auto obj = it.value().toObject();
+        quotes.push_back(MarketQuote { it.key(), obj.value("price").toDouble(), obj.value("change").toDouble(),
+                                       obj.value("change_percent").toDouble() });
     }
-    if (!toInsert.isEmpty()) {
-        int start = static_cast<int>(m_rows.size());
-        int end = start + toInsert.size() - 1;
-        beginInsertRows(QModelIndex(), start, end);
-        m_rows.insert(m_rows.end(), toInsert.begin(), toInsert.end());
-        endInsertRows();
-        // Update map for newly inserted rows
-        for (int i = start; i <= end; ++i) {
-            m_indexMap.insert(m_rows[static_cast<size_t>(i)].symbol, i);
-            emit rowAnimated(i);
+}
+
+void MarketModel::updateFromMap(const QJsonObject& rootObj) {
+    m_snapshot.source = QByteArray();
+    m_snapshot.scanned.clear();
+    m_snapshot.quotes.clear();
+    quotesFromMap(rootObj, m_snapshot.quotes);
+    applySnapshot(m_snapshot);
+}
+
+void MarketModel::updateRow(int idx, double price, double change, double changePct) {
+    if (idx < 0 || idx >= rowCount()) return;
+    const size_t i = static_cast<size_t>(idx);
+    const qint8 direction = directionOf(change);
+    quint8 roles = 0;
+    if (m_price[i] != price) { m_price[i] = price; roles |= PriceBit; }
+    if (m_change[i] != change) { m_change[i] = change; roles |= ChangeBit; }
+    if (m_changePct[i] != changePct) { m_changePct[i] = changePct; roles |= ChangePercentBit; }
+    if (m_direction[i] != direction) { m_direction[i] = direction; roles |= DirectionBit; }
+    if (!roles) return;
+    if (m_dirtyRoles.size() < m_symbols.size()) m_dirtyRoles.resize(m_symbols.size(), 0);
+    if (!m_dirtyRoles[i]) m_dirtyRows.push_back(idx);
+    m_dirtyRoles[i] |= roles;
+}
+
+void MarketModel::flushChanges() {
+    QVector<int> animated;
+    animated.reserve(static_cast<int>(m_dirtyRows.size()));
+    std::sort(m_dirtyRows.begin(), m_dirtyRows.end());
+    for (size_t k = 0; k < m_dirtyRows.size();) {
+        const int first = m_dirtyRows[k];
+        int last = first;
+        quint8 mask = 0;
+        // zusammenhängende Zeilen zu einem Bereich, Rollen als Vereinigung der tatsächlich geänderten
+        do {
+            last = m_dirtyRows[k];
+            mask |= m_dirtyRoles[static_cast<size_t>(last)];
+            m_dirtyRoles[static_cast<size_t>(last)] = 0;
+            animated.push_back(last);
+            ++k;
+        } while (k < m_dirtyRows.size() && m_dirtyRows[k] == last + 1);
+        QVector<int> roles;
+        if (mask & PriceBit) roles.push_back(PriceRole);
+        if (mask & ChangeBit) roles.push_back(ChangeRole);
+        if (mask & ChangePercentBit) roles.push_back(ChangePercentRole);
+        if (mask & DirectionBit) roles.push_back(DirectionRole);
+        emit dataChanged(index(first), index(last), roles);
+    }
+    m_dirtyRows.clear();
+    if (m_insertedFrom >= 0) {
+        for (int i = m_insertedFrom; i < rowCount(); ++i) animated.push_back(i);
+        m_insertedFrom = -1;
+    }
+    if (!animated.isEmpty()) emit rowsAnimated(animated);
+}
+
+void MarketModel::applyQuotes(const std::vector<MarketQuote>& quotes) {
+    stageQuotes(quotes);
+    flushChanges();
+}
+
+void MarketModel::stageQuotes(const std::vector<MarketQuote>& quotes) {
+    // Kosten ~ Anzahl geänderter Symbole, unabhängig von der Größe des Universums
+    std::vector<MarketQuote> toInsert;
+    const int rows = rowCount();
+    for (const auto& q : quotes) {
+        auto it = m_indexMap.constFind(q.symbol);
+        if (it != m_indexMap.constEnd()) {
+            const int idx = it.value();
+            if (idx < rows) updateRow(idx, q.price, q.change, q.changePercent);
+            else toInsert[static_cast<size_t>(idx - rows)] = q; // gleiches neues Symbol mehrfach im Batch: letzter Wert gewinnt
+            continue;
         }
+        m_indexMap.insert(q.symbol, rows + static_cast<int>(toInsert.size()));
+        toInsert.push_back(q);
+    }
+    if (toInsert.empty()) return;
+    const int end = rows + static_cast<int>(toInsert.size()) - 1;
+    beginInsertRows(QModelIndex(), rows, end);
+    for (const auto& q : toInsert) {
+        m_symbols.push_back(q.symbol);
+        m_price.push_back(q.price);
+        m_change.push_back(q.change);
+        m_changePct.push_back(q.changePercent);
+        m_direction.push_back(directionOf(q.change));
     }
+    endInsertRows();
+    ++m_generation;
+    m_layout.reset();
+    if (m_insertedFrom < 0) m_insertedFrom = rows;
+}
+
+void MarketModel::removeSymbolsNotIn(const QSet<QString>& keep) {
+    m_scanSeen.resize(m_symbols.size());
+    for (size_t i = 0; i < m_symbols.size(); ++i) m_scanSeen[i] = keep.contains(m_symbols[i]) ? 1 : 0;
+    dropRows(m_scanSeen);
+}
+
+void MarketModel::dropRows(const std::vector<char>& keep) {
+    bool removed = false;
+    for (int i = rowCount() - 1; i >= 0;) {
+        if (keep[static_cast<size_t>(i)]) { --i; continue; }
+        const int last = i;
+        while (i >= 0 && !keep[static_cast<size_t>(i)]) --i;
+        const int first = i + 1;
+        beginRemoveRows(QModelIndex(), first, last);
+        auto eraseRange = [first, last](auto& column) { column.erase(column.begin() + first, column.begin() + last + 1); };
+        eraseRange(m_symbols);
+        eraseRange(m_price);
+        eraseRange(m_change);
+        eraseRange(m_changePct);
+        eraseRange(m_direction);
+        endRemoveRows();
+        removed = true;
+    }
+    if (!removed) return;
+    rebuildIndex();
+    ++m_generation;
+    m_layout.reset();
+}
+
+void MarketModel::rebuildIndex() {
+    m_indexMap.clear();
+    for (int i = 0; i < rowCount(); ++i) m_indexMap.insert(m_symbols[static_cast<size_t>(i)], i);
 }
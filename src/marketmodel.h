@@ -2,13 +2,46 @@
 #include <QAbstractListModel>
 #include <vector>
 #include <QString>
+#include <QSet>
+#include <QByteArray>
+#include <QVector>
+#include <memory>
+#include "marketjsonscanner.h"
 
-struct MarketRow {
+// Einzelnes Symbol-Update (z.B. aus dem market_ticks Stream)
+struct MarketQuote {
     QString symbol;
     double price = 0.0;
     double change = 0.0;
     double changePercent = 0.0;
-    int direction = 0; // -1,0,1
+};
+
+// Zeilenbelegung des Models zu einem Zeitpunkt; unveränderlich, darf in den Decode-Thread.
+// generation wechselt bei jedem Einfügen/Entfernen von Zeilen.
+struct MarketLayout {
+    quint64 generation = 0;
+    std::vector<QString> symbols;
+    QHash<QString, int> index;
+};
+
+// Abgleich eines Snapshots gegen ein MarketLayout: Zielzeile je Quote nach dem Entfernen (-1 = neu),
+// keep je Zeile des Layouts, neue Symbole in Snapshot-Reihenfolge
+struct MarketDiff {
+    std::shared_ptr<const MarketLayout> layout;
+    std::vector<int> rows;
+    std::vector<char> keep;
+    bool removes = false;
+    std::vector<MarketQuote> inserted;
+};
+
+// Voll-Snapshot von market_data, ohne Zugriff auf das Model dekodiert (darf im Decode-Thread entstehen).
+// Genau einer der beiden Vektoren ist befüllt: scanned (Scanner-Pfad, Symbole zeigen in source) oder quotes.
+// diff ist optional vorberechnet (diffSnapshot); passt er nicht mehr zum Model, rechnet applySnapshot neu.
+struct MarketSnapshot {
+    QByteArray source;
+    std::vector<MarketJsonQuote> scanned;
+    std::vector<MarketQuote> quotes;
+    MarketDiff diff;
 };
 
 class MarketModel : public QAbstractListModel {
@@ -29,14 +62,61 @@ public:
     QHash<int, QByteArray> roleNames() const override;
 
     void updateFromJson(const QByteArray& jsonBytes);
+    // Decode-Stufe (thread-safe, ohne Model-Zustand): CBOR, Scanner, LenientJson in dieser Reihenfolge
+    static bool decodeSnapshot(const QByteArray& bytes, MarketSnapshot& out);
+    // Aktuelle Zeilenbelegung (GUI Thread), bleibt bis zur nächsten Strukturänderung dasselbe Objekt
+    std::shared_ptr<const MarketLayout> layout() const;
+    // Decode-Stufe (thread-safe): Symbol-Lookup und Zeilen-Abgleich gegen layout vorab berechnen
+    static void diffSnapshot(MarketSnapshot& snapshot, const std::shared_ptr<const MarketLayout>& layout);
+    // Apply-Stufe im GUI Thread: Zeilen aktualisieren, fehlende entfernen, neue anhängen (mit passendem diff ohne Lookup)
+    void applySnapshot(const MarketSnapshot& snapshot);
     // Neue Methode für direkten Map Update (kann intern genutzt werden)
     void updateFromMap(const QJsonObject& rootObj);
+    // Delta-Update: nur die übergebenen Symbole ändern/einfügen, keine Zeilen entfernen
+    void applyQuotes(const std::vector<MarketQuote>& quotes);
+    // Entfernt alle Zeilen, deren Symbol nicht in keep enthalten ist (Voll-Abgleich bei Delta-Layouts)
+    void removeSymbolsNotIn(const QSet<QString>& keep);
 
 signals:
-    void rowAnimated(int row);
+    // Einmal pro Update (Snapshot bzw. applyQuotes): geänderte und neu eingefügte Zeilen, aufsteigend
+    void rowsAnimated(const QVector<int>& rows);
 
 private:
-    std::vector<MarketRow> m_rows;
-    // symbol -> index map for quick lookup
+    // Spaltenweise Ablage (Index = Zeile = Symbol-Id), m_indexMap Symbol -> Zeile
+    std::vector<QString> m_symbols;
+    std::vector<double> m_price;
+    std::vector<double> m_change;
+    std::vector<double> m_changePct;
+    std::vector<qint8> m_direction; // -1,0,1
+
     QHash<QString,int> m_indexMap;
+    // Zähler der Strukturänderungen und daraus gebautes Layout (lazy, nullptr = veraltet)
+    quint64 m_generation {1};
+    mutable std::shared_ptr<const MarketLayout> m_layout;
+
+    // Änderungen eines Updates, bis flushChanges(): Rollen-Bitmaske je Zeile, betroffene Zeilen, erste neue Zeile
+    enum DirtyBits : quint8 { PriceBit = 1, ChangeBit = 2, ChangePercentBit = 4, DirectionBit = 8 };
+    std::vector<quint8> m_dirtyRoles;
+    std::vector<int> m_dirtyRows;
+    int m_insertedFrom {-1};
+
+    // Puffer für updateFromJson/applySnapshot, werden pro Snapshot wiederverwendet (keine Allokation im eingeschwungenen Zustand)
+    MarketSnapshot m_snapshot;
+    MarketDiff m_diff;
+    std::vector<char> m_scanSeen;
+
+    template <class Quote> static void computeDiff(const std::vector<Quote>& quotes, const MarketLayout& layout, MarketDiff& diff);
+    template <class Quote> void applyDiff(const std::vector<Quote>& quotes, const MarketDiff& diff);
+    // CBOR Variante (Streaming, ohne DOM)
+    static bool decodeCbor(const QByteArray& cborBytes, std::vector<MarketQuote>& quotes);
+    static void quotesFromMap(const QJsonObject& rootObj, std::vector<MarketQuote>& quotes);
+    // Schreibt Werte in eine bestehende Zeile und merkt geänderte Rollen vor (Signale erst in flushChanges)
+    void updateRow(int idx, double price, double change, double changePct);
+    // Update/Insert ohne Änderungssignale (Insert selbst per begin/endInsertRows als ein Block)
+    void stageQuotes(const std::vector<MarketQuote>& quotes);
+    // Entfernt alle Zeilen mit keep[i] == 0, zusammenhängende Bereiche mit einem beginRemoveRows
+    void dropRows(const std::vector<char>& keep);
+    void rebuildIndex();
+    // Ein dataChanged je zusammenhängendem Bereich (nur geänderte Rollen), danach ein rowsAnimated
+    void flushChanges();
 };
@@ -1,4 +1,5 @@
 #include "marketmodel_improved.h"
+#include "lenientjson.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonValue>
@@ -160,21 +161,10 @@ void MarketModel::updateFromJson(const QByteArray& jsonBytes) {
     auto start = std::chrono::steady_clock::now();
     
     QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(jsonBytes, &error);
-    
+    QJsonDocument doc = LenientJson::parse(jsonBytes, &error);
     if (error.error != QJsonParseError::NoError) {
-        // Try Python dict format conversion
-        QString dataStr = QString::fromUtf8(jsonBytes);
-        if (dataStr.startsWith("{'") || dataStr.startsWith("{\"")) {
-            QString jsonStr = dataStr;
-            jsonStr.replace("'", "\"");
-            doc = QJsonDocument::fromJson(jsonStr.toUtf8(), &error);
-        }
-        
-        if (error.error != QJsonParseError::NoError) {
-            qWarning() << "MarketModel: JSON parse error:" << error.errorString();
-            return;
-        }
+        qWarning() << "MarketModel: JSON parse error:" << error.errorString();
+        return;
     }
     
     if (doc.isObject()) {
@@ -0,0 +1,194 @@
+// Market Ticks Stream Consumer (XREAD BLOCK + Snapshot-Resync)
+#include "marketstreamconsumer.h"
+#include "marketmodel.h"
+#include <QByteArray>
+#include <QDebug>
+#include <QTimer>
+#include <cstdlib>
+#include <unordered_map>
+#include <utility>
+
+#ifndef REDIS_STUB
+#if defined(HIREDIS_VENDORED)
+#include <hiredis.h>
+#else
+#include <hiredis/hiredis.h>
+#endif
+#endif
+
+namespace {
+#ifndef REDIS_STUB
+std::string replyString(const redisReply* r) {
+    return (r && r->str && (r->type == REDIS_REPLY_STRING || r->type == REDIS_REPLY_STATUS || r->type == REDIS_REPLY_ERROR)) ? std::string(r->str, r->len) : std::string();
+}
+#endif
+
+// Stream-ID "<ms>-<seq>" numerisch vergleichbar machen
+std::pair<unsigned long long, unsigned long long> parseId(const std::string& id) {
+    char* end = nullptr;
+    unsigned long long ms = std::strtoull(id.c_str(), &end, 10);
+    unsigned long long seq = (end && *end == '-') ? std::strtoull(end + 1, nullptr, 10) : 0;
+    return { ms, seq };
+}
+
+bool idGreater(const std::string& a, const std::string& b) { return parseId(a) > parseId(b); }
+
+struct StreamInfo {
+    std::string lastGeneratedId;
+    std::string maxDeletedId;  // Redis >= 7
+    std::string firstEntryId;
+};
+
+#ifndef REDIS_STUB
+// XINFO STREAM (RESP2): flache Liste aus Feld/Wert Paaren
+StreamInfo parseStreamInfo(const redisReply* r) {
+    StreamInfo info;
+    if (!r || r->type != REDIS_REPLY_ARRAY) return info;
+    for (size_t i = 0; i + 1 < r->elements; i += 2) {
+        const std::string field = replyString(r->element[i]);
+        const redisReply* v = r->element[i + 1];
+        if (field == "last-generated-id") info.lastGeneratedId = replyString(v);
+        else if (field == "max-deleted-entry-id") info.maxDeletedId = replyString(v);
+        else if (field == "first-entry" && v && v->type == REDIS_REPLY_ARRAY && v->elements >= 1) info.firstEntryId = replyString(v->element[0]);
+    }
+    return info;
+}
+#endif
+} // namespace
+
+MarketStreamConsumer::MarketStreamConsumer(MarketModel* model, const QString& host, int port, const QString& password, QObject* parent)
+    : QObject(parent), m_client(host.toStdString(), port, 0, password.toStdString()), m_model(model) {
+    setBlockMs(m_blockMs);
+    connect(&m_client, &RedisAsyncClient::connected, this, [this]() {
+        ++m_generation;
+        resync(); // während der Trennung verpasste/getrimmte Ticks -> immer neu aufsetzen
+    });
+    connect(&m_client, &RedisAsyncClient::disconnected, this, [this]() {
+        ++m_generation;
+        setStreaming(false);
+    });
+    connect(&m_client, &RedisAsyncClient::errorOccurred, this, [](const QString& msg) {
+        qWarning() << "market stream redis:" << msg;
+    });
+}
+
+void MarketStreamConsumer::setBlockMs(int ms) {
+    m_blockMs = ms;
+    // XREAD BLOCK darf nicht in den Command-Timeout laufen
+    m_client.setCommandTimeoutMs(ms + 3000);
+}
+
+void MarketStreamConsumer::start() {
+    m_client.connectToServer();
+}
+
+void MarketStreamConsumer::stop() {
+    ++m_generation;
+    m_client.disconnectFromServer();
+    setStreaming(false);
+}
+
+void MarketStreamConsumer::resync() {
+    const quint64 gen = m_generation;
+    ++m_resyncCount;
+    m_gapCheckFrom.clear();
+    // MULTI: zwischen XINFO und GET kann kein anderer Client schreiben -> Snapshot passt exakt zur ID
+    m_client.command({"MULTI"}, nullptr);
+    m_client.command({"XINFO", "STREAM", m_streamKey}, nullptr);
+    m_client.command({"GET", m_snapshotKey}, nullptr);
+    m_client.command({"EXEC"}, [this, gen](redisReply* reply) {
+#ifndef REDIS_STUB
+        if (gen != m_generation || !reply) return; // Disconnect -> connected() resynct erneut
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2) {
+            qWarning() << "market stream: resync failed";
+            return;
+        }
+        const redisReply* info = reply->element[0];
+        const redisReply* snapshot = reply->element[1];
+        // Stream existiert (noch) nicht -> ab Anfang lesen, sobald er angelegt wird
+        m_lastId = (info->type == REDIS_REPLY_ERROR) ? std::string("0-0") : parseStreamInfo(info).lastGeneratedId;
+        if (m_lastId.empty()) m_lastId = "0-0";
+        if (snapshot->type == REDIS_REPLY_STRING && m_model) {
+            m_model->updateFromJson(QByteArray(snapshot->str, static_cast<qsizetype>(snapshot->len)));
+        }
+        setStreaming(true);
+        emit resynced();
+        readNext();
+#else
+        Q_UNUSED(reply); Q_UNUSED(gen);
+#endif
+    });
+}
+
+void MarketStreamConsumer::readNext() {
+#ifndef REDIS_STUB
+    const quint64 gen = m_generation;
+    if (!m_client.isConnected()) return;
+    if (!m_gapCheckFrom.empty()) {
+        const std::string from = std::move(m_gapCheckFrom);
+        m_gapCheckFrom.clear();
+        m_client.command({"XINFO", "STREAM", m_streamKey}, [this, gen, from](redisReply* reply) {
+            if (gen != m_generation || !reply) return;
+            const StreamInfo info = parseStreamInfo(reply);
+            // Redis >= 7: max-deleted-entry-id > from heißt, Einträge nach der Start-ID des vollen Batches wurden
+            // getrimmt (XREAD liefert dann still ab dem ersten verbliebenen Eintrag).
+            // Ältere Server: erster verbliebener Eintrag liegt hinter from (konservativ).
+            bool gap = !info.maxDeletedId.empty() ? idGreater(info.maxDeletedId, from)
+                                                 : (!info.firstEntryId.empty() && idGreater(info.firstEntryId, from));
+            if (gap) {
+                qInfo() << "market stream: consumer fell behind MAXLEN, resync from" << QString::fromStdString(m_snapshotKey);
+                resync();
+            } else {
+                readNext();
+            }
+        });
+        return;
+    }
+    m_client.command({"XREAD", "COUNT", std::to_string(m_batchCount), "BLOCK", std::to_string(m_blockMs),
+                      "STREAMS", m_streamKey, m_lastId},
+                     [this, gen, from = m_lastId](redisReply* reply) {
+        if (gen != m_generation || !reply) return;
+        if (reply->type == REDIS_REPLY_ERROR) {
+            // z.B. falscher Key-Typ: nicht im Kreis drehen, nach einer BLOCK-Periode erneut versuchen
+            qWarning() << "market stream: XREAD failed:" << QString::fromStdString(replyString(reply));
+            QTimer::singleShot(m_blockMs, this, [this, gen]() { if (gen == m_generation) readNext(); });
+            return;
+        }
+        if (reply->type == REDIS_REPLY_ARRAY && reply->elements > 0) {
+            // [[stream, [[id, [field, value, ...]], ...]]]
+            const redisReply* entries = reply->element[0]->elements >= 2 ? reply->element[0]->element[1] : nullptr;
+            if (entries && entries->type == REDIS_REPLY_ARRAY && entries->elements > 0) {
+                std::vector<MarketQuote> quotes;
+                std::unordered_map<std::string, size_t> bySymbol; // mehrere Ticks pro Symbol -> nur der letzte
+                for (size_t i = 0; i < entries->elements; ++i) {
+                    const redisReply* entry = entries->element[i];
+                    if (entry->type != REDIS_REPLY_ARRAY || entry->elements < 2) continue;
+                    m_lastId = replyString(entry->element[0]);
+                    const redisReply* fields = entry->element[1];
+                    MarketQuote q;
+                    std::string symbol;
+                    for (size_t f = 0; f + 1 < fields->elements; f += 2) {
+                        const std::string name = replyString(fields->element[f]);
+                        const std::string value = replyString(fields->element[f + 1]);
+                        if (name == "symbol") symbol = value;
+                        else if (name == "price") q.price = std::strtod(value.c_str(), nullptr);
+                        else if (name == "change") q.change = std::strtod(value.c_str(), nullptr);
+                        else if (name == "change_percent") q.changePercent = std::strtod(value.c_str(), nullptr);
+                    }
+                    if (symbol.empty()) continue;
+                    q.symbol = QString::fromStdString(symbol);
+                    auto it = bySymbol.find(symbol);
+                    if (it != bySymbol.end()) quotes[it->second] = q;
+                    else { bySymbol.emplace(symbol, quotes.size()); quotes.push_back(q); }
+                }
+                m_tickCount += entries->elements;
+                if (entries->elements >= static_cast<size_t>(m_batchCount)) m_gapCheckFrom = from;
+                if (m_model && !quotes.empty()) m_model->applyQuotes(quotes);
+                emit ticksApplied(static_cast<int>(quotes.size()));
+            }
+        }
+        // nil = BLOCK Timeout ohne neue Einträge
+        readNext();
+    });
+#endif
+}
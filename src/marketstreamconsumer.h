@@ -0,0 +1,59 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <string>
+#include "redisasyncclient.h"
+
+class MarketModel;
+
+// Inkrementeller Market-Ingest aus dem Stream market_ticks (XREAD BLOCK, eigene Verbindung).
+// Start/Reconnect: MULTI { XINFO STREAM; GET market_data } EXEC -> Snapshot + passende Stream-ID atomar,
+// danach nur noch Deltas ab der zuletzt gesehenen ID. Ist der Consumer hinter MAXLEN zurückgefallen
+// (Einträge nach lastId bereits getrimmt), wird einmal aus dem Snapshot resynchronisiert.
+class MarketStreamConsumer : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool streaming READ isStreaming NOTIFY streamingChanged)
+public:
+    explicit MarketStreamConsumer(MarketModel* model, const QString& host = "127.0.0.1", int port = 6380,
+                                  const QString& password = QString(), QObject* parent = nullptr);
+
+    void setStreamKey(const QString& key) { m_streamKey = key.toStdString(); }
+    void setSnapshotKey(const QString& key) { m_snapshotKey = key.toStdString(); }
+    void setBlockMs(int ms);
+    void setBatchCount(int n) { m_batchCount = n; }
+
+    // verbunden und Snapshot geladen -> market_data muss nicht mehr gepollt werden
+    bool isStreaming() const { return m_streaming; }
+    QString lastId() const { return QString::fromStdString(m_lastId); }
+    quint64 tickCount() const { return m_tickCount; }
+    quint64 resyncCount() const { return m_resyncCount; }
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void streamingChanged(bool streaming);
+    void resynced();
+    void ticksApplied(int symbols);
+
+private:
+    RedisAsyncClient m_client;
+    MarketModel* m_model;
+    std::string m_streamKey {"market_ticks"};
+    std::string m_snapshotKey {"market_data"};
+    std::string m_lastId {"0-0"};
+    int m_blockMs {2000};
+    int m_batchCount {500};
+    // letzter Batch war voll -> wir hängen hinterher: vor dem nächsten XREAD prüfen, ob nach der Start-ID dieses
+    // Batches getrimmt wurde (nicht gegen m_lastId, das steht schon am Batch-Ende). Leer = keine Prüfung fällig
+    std::string m_gapCheckFrom;
+    bool m_streaming {false};
+    quint64 m_generation {0};  // erhöht bei Reconnect/Stop, alte Callbacks verwerfen sich selbst
+    quint64 m_tickCount {0};
+    quint64 m_resyncCount {0};
+
+    void resync();
+    void readNext();
+    void setStreaming(bool s) { if (s != m_streaming) { m_streaming = s; emit streamingChanged(m_streaming); } }
+};
@@ -1,11 +1,12 @@
 #include "notificationsmodel.h"
+#include "cborreader.h"
+#include "fieldconvert.h"
+#include "lenientjson.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 
-NotificationsModel::NotificationsModel(QObject* parent): QAbstractListModel(parent) {}
-
-int NotificationsModel::rowCount(const QModelIndex& parent) const { return parent.isValid()?0:m_rows.size(); }
+NotificationsModel::NotificationsModel(QObject* parent): RecordListModel(parent) {}
 
 QVariant NotificationsModel::data(const QModelIndex& index, int role) const {
     if(!index.isValid()||index.row()<0||index.row()>=m_rows.size()) return {};
@@ -15,24 +16,28 @@ QVariant NotificationsModel::data(const QModelIndex& index, int role) const {
         case TypeRole: return r.type;
         case TitleRole: return r.title;
         case MessageRole: return r.message;
-        case TimestampRole: return r.timestamp;
+        case TimestampRole: return FieldConvert::formatIsoMillis(r.timestamp);
+        case TimestampMsRole: return r.timestamp.ms;
         case ReadRole: return r.read;
     }
     return {};
 }
 
 QHash<int,QByteArray> NotificationsModel::roleNames() const {
-    return {{IdRole,"id"},{TypeRole,"type"},{TitleRole,"title"},{MessageRole,"message"},{TimestampRole,"timestamp"},{ReadRole,"read"}};
+    return {{IdRole,"id"},{TypeRole,"type"},{TitleRole,"title"},{MessageRole,"message"},{TimestampRole,"timestamp"},{ReadRole,"read"},{TimestampMsRole,"timestampMs"}};
 }
 
 void NotificationsModel::updateFromJson(const QByteArray& jsonBytes){
-    QJsonParseError err{}; auto doc=QJsonDocument::fromJson(jsonBytes,&err); if(err.error!=QJsonParseError::NoError||!doc.isArray()) return; auto arr=doc.array();
-    QVector<NotificationRow> newRows; newRows.reserve(arr.size());
-    for(auto v: arr){ if(!v.isObject()) continue; auto o=v.toObject();
-        NotificationRow n; n.id=o.value("id").toInt(); n.type=o.value("type").toString(); n.title=o.value("title").toString();
-        n.message=o.value("message").toString(); n.timestamp=o.value("timestamp").toString(); n.read=o.value("read").toBool();
-        newRows.push_back(n); }
-    beginResetModel(); m_rows=std::move(newRows); endResetModel();
+    QVector<NotificationRow> rows;
+    if(decodeRows(jsonBytes, rows)) setRows(rows);
+}
+
+bool NotificationsModel::decodeRows(const QByteArray& jsonBytes, QVector<NotificationRow>& out){
+    if(CborReader::isCbor(jsonBytes)) return RecordDecoder::decodeCborArray(jsonBytes, out);
+    if(RecordDecoder::decodeArray(jsonBytes, out)) return true;
+    QJsonParseError err{}; auto doc=LenientJson::parse(jsonBytes, &err); if(err.error!=QJsonParseError::NoError||!doc.isArray()) return false;
+    RecordDecoder::decodeJsonArray(doc.array(), out);
+    return true;
 }
 
 void NotificationsModel::markRead(int row){
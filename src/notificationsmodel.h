@@ -1,30 +1,38 @@
 #pragma once
-#include <QAbstractListModel>
 #include <QVector>
 #include <QString>
+#include "fieldconvert.h"
+#include "recorddecoder.h"
+#include "recordlistmodel.h"
 
 struct NotificationRow {
     int id = 0;
     QString type; // success, warning, error, info
     QString title;
     QString message;
-    QString timestamp;
+    EpochMs timestamp; // Anzeige als ISO-8601 bzw. Originaltext (timestamp Rolle), Sortieren/Vergleichen über timestampMs
     bool read = false;
 };
 
-class NotificationsModel : public QAbstractListModel {
+template<> struct RecordSchema<NotificationRow> {
+    static constexpr auto fields = std::make_tuple(&NotificationRow::id, &NotificationRow::type, &NotificationRow::title,
+                                                   &NotificationRow::message, &NotificationRow::timestamp, &NotificationRow::read);
+    static constexpr RecordKey keys[] = {
+        {"id", 0, false}, {"type", 1, false}, {"title", 2, false}, {"message", 3, false}, {"timestamp", 4, false}, {"read", 5, false},
+    };
+};
+
+class NotificationsModel : public RecordListModel<NotificationRow> {
     Q_OBJECT
 public:
-    enum Roles { IdRole = Qt::UserRole + 300, TypeRole, TitleRole, MessageRole, TimestampRole, ReadRole };
+    enum Roles { IdRole = Qt::UserRole + 300, TypeRole, TitleRole, MessageRole, TimestampRole, ReadRole, TimestampMsRole };
     explicit NotificationsModel(QObject* parent=nullptr);
 
-    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role) const override;
     QHash<int,QByteArray> roleNames() const override;
 
     void updateFromJson(const QByteArray& jsonBytes); // array
+    // Decode-Stufe ohne Model-Zustand (thread-safe) und Apply-Stufe im GUI Thread
+    static bool decodeRows(const QByteArray& bytes, QVector<NotificationRow>& out);
     Q_INVOKABLE void markRead(int row);
-
-private:
-    QVector<NotificationRow> m_rows;
 };
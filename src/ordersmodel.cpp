@@ -1,11 +1,12 @@
 #include "ordersmodel.h"
+#include "cborreader.h"
+#include "fieldconvert.h"
+#include "lenientjson.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 
-OrdersModel::OrdersModel(QObject* parent): QAbstractListModel(parent) {}
-
-int OrdersModel::rowCount(const QModelIndex& parent) const { return parent.isValid()?0:m_rows.size(); }
+OrdersModel::OrdersModel(QObject* parent): RecordListModel(parent) {}
 
 QVariant OrdersModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid()||index.row()<0||index.row()>=m_rows.size()) return {};
@@ -15,22 +16,26 @@ QVariant OrdersModel::data(const QModelIndex& index, int role) const {
         case OSideRole: return r.side;
         case OPriceRole: return r.price;
         case OStatusRole: return r.status;
-        case OTimestampRole: return r.timestamp;
+        case OTimestampRole: return FieldConvert::formatIsoMillis(r.timestamp);
+        case OTimestampMsRole: return r.timestamp.ms;
     }
     return {};
 }
 
 QHash<int,QByteArray> OrdersModel::roleNames() const {
-    return {{OTickerRole,"ticker"},{OSideRole,"side"},{OPriceRole,"price"},{OStatusRole,"status"},{OTimestampRole,"timestamp"}};
+    return {{OTickerRole,"ticker"},{OSideRole,"side"},{OPriceRole,"price"},{OStatusRole,"status"},{OTimestampRole,"timestamp"},{OTimestampMsRole,"timestampMs"}};
 }
 
 void OrdersModel::updateFromJson(const QByteArray& jsonBytes){
-    QJsonParseError err{}; auto doc=QJsonDocument::fromJson(jsonBytes,&err);
-    if(err.error!=QJsonParseError::NoError||!doc.isArray()) return; auto arr=doc.array();
-    QVector<OrderRow> newRows; newRows.reserve(arr.size());
-    for(auto v: arr){ if(!v.isObject()) continue; auto o=v.toObject();
-        OrderRow row; row.ticker=o.value("ticker").toString(); row.side=o.value("side").toString();
-        row.price=o.value("price").toDouble(); row.status=o.value("status").toString(); row.timestamp=o.value("timestamp").toString();
-        newRows.push_back(row); }
-    beginResetModel(); m_rows=std::move(newRows); endResetModel();
+    QVector<OrderRow> rows;
+    if(decodeRows(jsonBytes, rows)) setRows(rows);
+}
+
+bool OrdersModel::decodeRows(const QByteArray& jsonBytes, QVector<OrderRow>& out){
+    if(CborReader::isCbor(jsonBytes)) return RecordDecoder::decodeCborArray(jsonBytes, out);
+    if(RecordDecoder::decodeArray(jsonBytes, out)) return true;
+    QJsonParseError err{}; auto doc=LenientJson::parse(jsonBytes, &err);
+    if(err.error!=QJsonParseError::NoError||!doc.isArray()) return false;
+    RecordDecoder::decodeJsonArray(doc.array(), out);
+    return true;
 }
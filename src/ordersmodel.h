@@ -1,28 +1,33 @@
 #pragma once
-#include <QAbstractListModel>
 #include <QVector>
 #include <QString>
+#include "fieldconvert.h"
+#include "recorddecoder.h"
+#include "recordlistmodel.h"
 
 struct OrderRow {
     QString ticker;
     QString side; // buy/sell
     double price = 0.0;
     QString status; // open, filled, cancelled
-    QString timestamp;
+    EpochMs timestamp; // Anzeige als ISO-8601 bzw. Originaltext (timestamp Rolle), Sortieren/Vergleichen über timestampMs
 };
 
-class OrdersModel : public QAbstractListModel {
+template<> struct RecordSchema<OrderRow> {
+    static constexpr auto fields = std::make_tuple(&OrderRow::ticker, &OrderRow::side, &OrderRow::price, &OrderRow::status, &OrderRow::timestamp);
+    static constexpr RecordKey keys[] = { {"ticker", 0, false}, {"side", 1, false}, {"price", 2, false}, {"status", 3, false}, {"timestamp", 4, false} };
+};
+
+class OrdersModel : public RecordListModel<OrderRow> {
     Q_OBJECT
 public:
-    enum Roles { OTickerRole = Qt::UserRole + 200, OSideRole, OPriceRole, OStatusRole, OTimestampRole };
+    enum Roles { OTickerRole = Qt::UserRole + 200, OSideRole, OPriceRole, OStatusRole, OTimestampRole, OTimestampMsRole };
     explicit OrdersModel(QObject* parent = nullptr);
 
-    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role) const override;
     QHash<int,QByteArray> roleNames() const override;
 
     void updateFromJson(const QByteArray& jsonBytes); // array of objects
-
-private:
-    QVector<OrderRow> m_rows;
+    // Decode-Stufe ohne Model-Zustand (thread-safe) und Apply-Stufe im GUI Thread
+    static bool decodeRows(const QByteArray& bytes, QVector<OrderRow>& out);
 };
@@ -1,7 +1,8 @@
 #pragma once
-#include <QAbstractListModel>
 #include <QVector>
 #include <QString>
+#include "recorddecoder.h"
+#include "recordlistmodel.h"
 
 struct PortfolioPosition {
     QString ticker;
@@ -10,18 +11,26 @@ struct PortfolioPosition {
     QString side; // long/short
 };
 
-class PortfolioModel : public QAbstractListModel {
+// symbol/avg_entry_price (Alpaca Namen) als Alias für ticker/avg_price
+template<> struct RecordSchema<PortfolioPosition> {
+    static constexpr auto fields = std::make_tuple(&PortfolioPosition::ticker, &PortfolioPosition::qty,
+                                                   &PortfolioPosition::avgPrice, &PortfolioPosition::side);
+    static constexpr RecordKey keys[] = {
+        {"ticker", 0, false}, {"qty", 1, false}, {"avg_price", 2, false}, {"side", 3, false},
+        {"symbol", 0, true}, {"avg_entry_price", 2, true},
+    };
+};
+
+class PortfolioModel : public RecordListModel<PortfolioPosition> {
     Q_OBJECT
 public:
     enum Roles { TickerRole = Qt::UserRole + 100, QtyRole, AvgPriceRole, SideRole };
     explicit PortfolioModel(QObject* parent = nullptr);
 
-    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role) const override;
     QHash<int,QByteArray> roleNames() const override;
 
     void updateFromJson(const QByteArray& jsonBytes); // expects array of objects
-
-private:
-    QVector<PortfolioPosition> m_rows;
+    // Decode-Stufe ohne Model-Zustand (thread-safe) und Apply-Stufe im GUI Thread
+    static bool decodeRows(const QByteArray& bytes, QVector<PortfolioPosition>& out);
 };
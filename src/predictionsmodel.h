@@ -4,9 +4,17 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include "cborreader.h"
+#include "lenientjson.h"
+#include "recorddecoder.h"
 
 struct ForecastPoint { QString t; double v; };
 
+template<> struct RecordSchema<ForecastPoint> {
+    static constexpr auto fields = std::make_tuple(&ForecastPoint::t, &ForecastPoint::v);
+    static constexpr RecordKey keys[] = { {"t", 0, false}, {"v", 1, false}, {"timestamp", 0, true}, {"predicted_price", 1, true} };
+};
+
 class PredictionsModel : public QAbstractListModel {
     Q_OBJECT
 public:
@@ -19,8 +27,15 @@ public:
         switch(role){ case TimeRole: return p.t; case ValueRole: return p.v; default: return {}; }
     }
     QHash<int,QByteArray> roleNames() const override { return {{TimeRole,"t"},{ValueRole,"v"}}; }
-    Q_INVOKABLE void updateFromJson(const QByteArray& bytes) {
-        QJsonParseError err{}; auto doc=QJsonDocument::fromJson(bytes,&err); if(err.error!=QJsonParseError::NoError||!doc.isArray()) return; auto arr=doc.array(); QVector<ForecastPoint> fresh; fresh.reserve(arr.size()); for(auto v:arr){ if(!v.isObject()) continue; auto o=v.toObject(); ForecastPoint fp{ o.value("t").toString(), o.value("v").toDouble() }; fresh.push_back(fp);} beginResetModel(); m_points=std::move(fresh); endResetModel(); emit changed(); }
+    Q_INVOKABLE void updateFromJson(const QByteArray& bytes) { QVector<ForecastPoint> points; if (decodePoints(bytes, points)) setPoints(points); }
+    // Decode-Stufe ohne Model-Zustand (thread-safe); setPoints ist die Apply-Stufe im GUI Thread
+    static bool decodePoints(const QByteArray& bytes, QVector<ForecastPoint>& out) {
+        if (CborReader::isCbor(bytes)) return RecordDecoder::decodeCborArray(bytes, out);
+        if (RecordDecoder::decodeArray(bytes, out)) return true;
+        // Python-Literal/kaputtes JSON: DOM über dieselbe Key-Tabelle (timestamp/predicted_price, numerisches t als Text)
+        QJsonParseError err{}; auto doc=LenientJson::parse(bytes, &err); if(err.error!=QJsonParseError::NoError||!doc.isArray()) return false;
+        RecordDecoder::decodeJsonArray(doc.array(), out); return true; }
+    void setPoints(const QVector<ForecastPoint>& points) { beginResetModel(); m_points=points; endResetModel(); emit changed(); }
     const QVector<ForecastPoint>& points() const { return m_points; }
 signals: void changed();
 private: QVector<ForecastPoint> m_points; };
@@ -0,0 +1,293 @@
+// Tokenizer und Feld-Zuweisungen für RecordDecoder (siehe recorddecoder.h)
+#include "recorddecoder.h"
+#include "jsonscan.h"
+#include <QLocale>
+#include <algorithm>
+#include <cmath>
+
+using namespace JsonScan;
+
+namespace {
+bool readHex4(const char* p, const char* end, uint& out) {
+    if (end - p < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = p[i];
+        const int h = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (h < 0) return false;
+        out = (out << 4) | uint(h);
+    }
+    return true;
+}
+
+void appendUtf8(QByteArray& dst, uint cp) {
+    if (cp < 0x80) {
+        dst.append(char(cp));
+    } else if (cp < 0x800) {
+        dst.append(char(0xC0 | (cp >> 6)));
+        dst.append(char(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        dst.append(char(0xE0 | (cp >> 12)));
+        dst.append(char(0x80 | ((cp >> 6) & 0x3F)));
+        dst.append(char(0x80 | (cp & 0x3F)));
+    } else {
+        dst.append(char(0xF0 | (cp >> 18)));
+        dst.append(char(0x80 | ((cp >> 12) & 0x3F)));
+        dst.append(char(0x80 | ((cp >> 6) & 0x3F)));
+        dst.append(char(0x80 | (cp & 0x3F)));
+    }
+}
+
+double numericText(const RecordScalar& v) {
+    return FieldConvert::toDouble(v.text, static_cast<size_t>(v.length));
+}
+
+// wie das Roh-Token im Cursor-Pfad: ganze Zahlen ohne Exponent (numerisches t -> "1726000000")
+QByteArray numberText(double v) {
+    if (std::trunc(v) == v && std::fabs(v) < 1e15) return QByteArray::number(qint64(v));
+    return QString::number(v, 'g', QLocale::FloatingPointShortest).toLatin1();
+}
+
+} // namespace
+
+RecordCursor::RecordCursor(const char* data, size_t size) : m_p(data), m_end(data + size) {
+    if (size >= 3 && std::memcmp(m_p, "\xEF\xBB\xBF", 3) == 0) m_p += 3; // UTF-8 BOM
+}
+
+bool RecordCursor::enterArray() {
+    m_p = skipWs(m_p, m_end);
+    if (m_p == m_end || *m_p != '[') return fail();
+    ++m_p;
+    m_arrayElements = 0;
+    return true;
+}
+
+bool RecordCursor::enterObject() {
+    m_p = skipWs(m_p, m_end);
+    if (m_p == m_end || *m_p != '{') return fail();
+    ++m_p;
+    m_objectFields = 0;
+    return true;
+}
+
+bool RecordCursor::nextRecord() {
+    for (;;) {
+        m_p = skipWs(m_p, m_end);
+        if (m_p == m_end) return fail();
+        if (*m_p == ']') { ++m_p; return false; }
+        if (m_arrayElements > 0) {
+            if (*m_p != ',') return fail();
+            m_p = skipWs(m_p + 1, m_end);
+            if (m_p == m_end) return fail();
+        }
+        ++m_arrayElements;
+        if (*m_p == '{') {
+            ++m_p;
+            m_objectFields = 0;
+            return true;
+        }
+        if (!skipValue(m_p, m_end)) return fail(); // Nicht-Objekte ignorieren wie die DOM Pfade
+    }
+}
+
+bool RecordCursor::nextKey(const char*& key, int& length) {
+    m_p = skipWs(m_p, m_end);
+    if (m_p == m_end) return fail();
+    if (*m_p == '}') { ++m_p; return false; }
+    if (m_objectFields > 0) {
+        if (*m_p != ',') return fail();
+        m_p = skipWs(m_p + 1, m_end);
+    }
+    ++m_objectFields;
+    if (m_p == m_end || *m_p != '"') return fail();
+    if (!readString(key, length)) return false;
+    m_p = skipWs(m_p, m_end);
+    if (m_p == m_end || *m_p != ':') return fail();
+    m_p = skipWs(m_p + 1, m_end);
+    return true;
+}
+
+bool RecordCursor::readValue(RecordScalar& out) {
+    out = RecordScalar();
+    if (m_p == m_end) return fail();
+    const char c = *m_p;
+    if (c == '"') {
+        out.type = RecordScalar::String;
+        return readString(out.text, out.length);
+    }
+    if (c == '-' || isDigit(c)) {
+        const char* start = m_p;
+        if (!parseNumber(m_p, m_end, out.number)) return fail();
+        out.type = RecordScalar::Number;
+        out.text = start;
+        out.length = static_cast<int>(m_p - start);
+        return true;
+    }
+    auto word = [this](const char* w, size_t n) {
+        if (static_cast<size_t>(m_end - m_p) < n || std::memcmp(m_p, w, n) != 0) return false;
+        m_p += n;
+        return true;
+    };
+    if (word("true", 4)) { out.type = RecordScalar::Bool; out.boolean = true; return true; }
+    if (word("false", 5)) { out.type = RecordScalar::Bool; return true; }
+    if (word("null", 4)) return true;
+    if (c == '{' || c == '[') {
+        out.type = RecordScalar::Other; // verschachtelt: nicht Teil der Schemas, Feld bleibt auf Default
+        return skipValue(m_p, m_end) || fail();
+    }
+    return fail(); // True/None/'...' usw. -> LenientJson
+}
+
+bool RecordCursor::atEnd() {
+    m_p = skipWs(m_p, m_end);
+    return m_p == m_end;
+}
+
+int RecordCursor::estimateRecords() const {
+    return static_cast<int>(std::count(m_p, m_end, '{'));
+}
+
+// m_p auf '"'; Escapes werden in m_scratch aufgelöst, sonst zeigt text direkt in den Puffer
+bool RecordCursor::readString(const char*& text, int& length) {
+    const char* start = m_p + 1;
+    const char* q = findQuoteOrEscape(start, m_end);
+    if (q == m_end) return fail();
+    if (*q == '"') {
+        text = start;
+        length = static_cast<int>(q - start);
+        m_p = q + 1;
+        return true;
+    }
+    m_scratch.clear();
+    const char* p = start;
+    for (;;) {
+        q = findQuoteOrEscape(p, m_end);
+        if (q == m_end) return fail();
+        m_scratch.append(p, static_cast<int>(q - p));
+        if (*q == '"') break;
+        if (q + 1 == m_end) return fail();
+        const char e = q[1];
+        p = q + 2;
+        switch (e) {
+            case 'n': m_scratch.append('\n'); break;
+            case 't': m_scratch.append('\t'); break;
+            case 'r': m_scratch.append('\r'); break;
+            case 'b': m_scratch.append('\b'); break;
+            case 'f': m_scratch.append('\f'); break;
+            case 'u': {
+                uint cp = 0;
+                if (!readHex4(p, m_end, cp)) return fail();
+                p += 4;
+                // Surrogatpaar (Zeichen > U+FFFF)
+                if (cp >= 0xD800 && cp < 0xDC00 && m_end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    uint low = 0;
+                    if (!readHex4(p + 2, m_end, low) || low < 0xDC00 || low > 0xDFFF) return fail();
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    p += 6;
+                }
+                appendUtf8(m_scratch, cp);
+                break;
+            }
+            default: m_scratch.append(e); break; // \" \\ \/
+        }
+    }
+    text = m_scratch.constData();
+    length = static_cast<int>(m_scratch.size());
+    m_p = q + 1;
+    return true;
+}
+
+namespace RecordDecoding {
+
+bool assign(double& target, const RecordScalar& v) {
+    if (v.type == RecordScalar::Number) target = v.number;
+    else if (v.type == RecordScalar::String) target = numericText(v); // "12.5" aus Python Workern
+    return true;
+}
+
+bool assign(qint64& target, const RecordScalar& v) {
+    if (v.type == RecordScalar::String) return false; // Text-Zeitstempel: DOM Pfad behält den Text
+    if (v.type == RecordScalar::Number) target = qint64(v.number);
+    return true;
+}
+
+bool assign(int& target, const RecordScalar& v) {
+    if (v.type == RecordScalar::Number) target = int(v.number);
+    else if (v.type == RecordScalar::String) target = int(numericText(v));
+    return true;
+}
+
+bool assign(bool& target, const RecordScalar& v) {
+    target = (v.type == RecordScalar::Bool && v.boolean);
+    return true;
+}
+
+bool assign(QString& target, const RecordScalar& v) {
+    if (v.type == RecordScalar::String) target = QString::fromUtf8(v.text, v.length);
+    else if (v.type == RecordScalar::Number) target = QString::fromLatin1(v.text, v.length);
+    return true;
+}
+
+bool assign(EpochMs& target, const RecordScalar& v) {
+    if (v.type == RecordScalar::String) target = FieldConvert::timestampFromText(v.text, static_cast<size_t>(v.length));
+    else if (v.type == RecordScalar::Number) target = FieldConvert::timestampFromNumber(v.number);
+    else target = EpochMs();
+    return true;
+}
+
+void scalarFromJson(const QJsonValue& v, RecordScalar& out, QByteArray& storage) {
+    out = RecordScalar();
+    switch (v.type()) {
+        case QJsonValue::Null: break;
+        case QJsonValue::Bool:
+            out.type = RecordScalar::Bool;
+            out.boolean = v.toBool();
+            break;
+        case QJsonValue::Double:
+            out.type = RecordScalar::Number;
+            out.number = v.toDouble();
+            storage = numberText(out.number);
+            break;
+        case QJsonValue::String:
+            out.type = RecordScalar::String;
+            storage = v.toString().toUtf8();
+            break;
+        default:
+            out.type = RecordScalar::Other;
+            return;
+    }
+    if (out.type == RecordScalar::Number || out.type == RecordScalar::String) {
+        out.text = storage.constData();
+        out.length = static_cast<int>(storage.size());
+    }
+}
+
+void scalarFromCbor(CborReader& reader, RecordScalar& out, QByteArray& storage) {
+    out = RecordScalar();
+    double number = 0.0;
+    bool boolean = false;
+    QString text;
+    switch (reader.readScalar(number, boolean, text)) {
+        case CborReader::NullScalar: return;
+        case CborReader::BoolScalar:
+            out.type = RecordScalar::Bool;
+            out.boolean = boolean;
+            return;
+        case CborReader::NumberScalar:
+            out.type = RecordScalar::Number;
+            out.number = number;
+            storage = numberText(number);
+            break;
+        case CborReader::StringScalar:
+            out.type = RecordScalar::String;
+            storage = text.toUtf8();
+            break;
+        default:
+            out.type = RecordScalar::Other;
+            return;
+    }
+    out.text = storage.constData();
+    out.length = static_cast<int>(storage.size());
+}
+
+} // namespace RecordDecoding
@@ -0,0 +1,340 @@
+#pragma once
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "cborreader.h"
+#include "fieldconvert.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+// Single-Pass Decoder für die festen Record-Schemas (redis.txt 2-5, 20): Array von flachen Objekten direkt in
+// einen QVector<T>, ohne QJsonDocument und ohne QJsonObject::value("...") pro Zeile.
+// Pro Struct wird einmal RecordSchema<T> spezialisiert:
+//   fields: Tupel von Member-Pointern (Zielspalten)
+//   keys:   JSON Key -> Index in fields; Alias-Keys (legacy_mapping aus schema_meta) zeigen auf dieselbe Spalte
+// Daraus entsteht zur Compile-Zeit eine perfekte Hash-Tabelle über alle Keys und eine Setter-Tabelle je Feld.
+// Alias-Keys schreiben nur, solange der kanonische Key im selben Objekt nicht vorkam (kanonisch gewinnt immer).
+// Zahlen als Strings werden toleriert (wie CborReader, per FieldConvert); qint64 Felder (Kerzen-t) akzeptieren nur
+// Zahlen, EpochMs Felder ISO-8601 Text oder epoch Zahlen.
+// false bei allem anderen (Python-Literal, Text-Zeitstempel, kaputtes JSON): Aufrufer nimmt den LenientJson Pfad.
+// Dieser DOM Fallback liest über decodeJsonArray/decodeJsonObject dieselbe Key-Tabelle (gleiche Aliase, gleiche Setter),
+// ebenso die CBOR Eingänge über readCborField/decodeCborArray.
+
+struct RecordKey {
+    const char* name;
+    int field;
+    bool alias;
+};
+
+template <class T> struct RecordSchema; // Spezialisierung pro Record-Typ (neben dem Struct)
+
+// Skalarer Wert eines Feldes; text zeigt in den Eingabepuffer bzw. den Escape-Puffer des Cursors (nur bis zum
+// nächsten readValue gültig). Bei Number ist text das Roh-Token.
+struct RecordScalar {
+    enum Type { Null, Bool, Number, String, Other };
+    Type type {Null};
+    double number {0.0};
+    bool boolean {false};
+    const char* text {nullptr};
+    int length {0};
+};
+
+// Tokenizer für [ {..}, {..} ] bzw. ein einzelnes {..}; Nicht-Objekte im Array werden übersprungen
+class RecordCursor {
+public:
+    RecordCursor(const char* data, size_t size);
+
+    bool enterArray();
+    bool enterObject();
+    // true: ein Objekt beginnt; false: Array zu Ende oder Fehler (failed())
+    bool nextRecord();
+    // true: key/length gesetzt, Wert folgt; false: Objekt zu Ende oder Fehler (failed())
+    bool nextKey(const char*& key, int& length);
+    bool readValue(RecordScalar& out);
+    // nur noch Whitespace übrig
+    bool atEnd();
+    bool failed() const { return m_failed; }
+    // Obergrenze für reserve(): Anzahl '{' im Rest
+    int estimateRecords() const;
+
+private:
+    const char* m_p;
+    const char* m_end;
+    bool m_failed {false};
+    int m_arrayElements {0};
+    int m_objectFields {0};
+    QByteArray m_scratch;
+
+    bool fail() { m_failed = true; return false; }
+    bool readString(const char*& text, int& length);
+};
+
+namespace RecordDecoding {
+
+bool assign(double& target, const RecordScalar& v);
+bool assign(qint64& target, const RecordScalar& v);
+bool assign(int& target, const RecordScalar& v);
+bool assign(bool& target, const RecordScalar& v);
+bool assign(QString& target, const RecordScalar& v);
+bool assign(EpochMs& target, const RecordScalar& v);
+
+// DOM Wert als Skalar für die Setter; storage hält den Text (Zahlen in kürzester Darstellung) während des Aufrufs
+void scalarFromJson(const QJsonValue& v, RecordScalar& out, QByteArray& storage);
+// Nächster CBOR Wert als Skalar, Text/Zahlen-Text wie scalarFromJson in storage
+void scalarFromCbor(CborReader& reader, RecordScalar& out, QByteArray& storage);
+
+constexpr size_t length(const char* s) {
+    size_t n = 0;
+    while (s[n]) ++n;
+    return n;
+}
+
+// FNV-1a mit Seed, identisch zur Compile-Zeit und zur Laufzeit
+constexpr uint32_t hashKey(const char* s, size_t n, uint32_t seed) {
+    uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 16);
+}
+
+constexpr size_t tableSizeFor(size_t keys) {
+    size_t size = 1;
+    while (size < keys * 2) size <<= 1;
+    return size;
+}
+
+template <size_t Size> struct PerfectHash {
+    uint32_t seed {0};
+    std::array<int, Size> table {};
+    bool found {false};
+};
+
+// Sucht den ersten Seed ohne Kollision (bei <= 64 Keys und Tabelle >= 2N nach wenigen Versuchen)
+template <size_t Size, size_t N> constexpr PerfectHash<Size> buildPerfectHash(const RecordKey (&keys)[N]) {
+    PerfectHash<Size> ph {};
+    for (uint32_t seed = 0; seed < 100000; ++seed) {
+        for (size_t i = 0; i < Size; ++i) ph.table[i] = -1;
+        bool collision = false;
+        for (size_t k = 0; k < N && !collision; ++k) {
+            const size_t slot = hashKey(keys[k].name, length(keys[k].name), seed) & (Size - 1);
+            if (ph.table[slot] >= 0) collision = true;
+            else ph.table[slot] = static_cast<int>(k);
+        }
+        if (!collision) {
+            ph.seed = seed;
+            ph.found = true;
+            return ph;
+        }
+    }
+    return ph;
+}
+
+template <class T> constexpr bool keysValid() {
+    using Schema = RecordSchema<T>;
+    for (const RecordKey& key : Schema::keys) {
+        if (key.field < 0 || static_cast<size_t>(key.field) >= std::tuple_size<decltype(Schema::fields)>::value) return false;
+    }
+    return true;
+}
+
+template <class T, size_t... I> constexpr auto keyLengths(std::index_sequence<I...>) {
+    return std::array<size_t, sizeof...(I)> { length(RecordSchema<T>::keys[I].name)... };
+}
+
+template <class T, size_t I> bool setField(T& record, const RecordScalar& v) {
+    return assign(record.*std::get<I>(RecordSchema<T>::fields), v);
+}
+
+template <class T, size_t... I> constexpr auto makeSetters(std::index_sequence<I...>) {
+    return std::array<bool (*)(T&, const RecordScalar&), sizeof...(I)> { &setField<T, I>... };
+}
+
+template <class T> struct SchemaTables {
+    using Schema = RecordSchema<T>;
+    static constexpr size_t kKeyCount = sizeof(Schema::keys) / sizeof(Schema::keys[0]);
+    static constexpr size_t kFieldCount = std::tuple_size<decltype(Schema::fields)>::value;
+    static constexpr size_t kTableSize = tableSizeFor(kKeyCount);
+    static_assert(kFieldCount <= 64, "RecordSchema supports at most 64 fields");
+    static_assert(keysValid<T>(), "RecordSchema key refers to a missing field");
+    static constexpr PerfectHash<kTableSize> kHash = buildPerfectHash<kTableSize>(Schema::keys);
+    static_assert(kHash.found, "no collision-free seed for RecordSchema keys");
+    static constexpr std::array<size_t, kKeyCount> kKeyLengths = keyLengths<T>(std::make_index_sequence<kKeyCount>());
+    static constexpr auto kSetters = makeSetters<T>(std::make_index_sequence<kFieldCount>());
+
+    // Index in Schema::keys oder -1
+    static int lookup(const char* key, int len) {
+        const int k = kHash.table[hashKey(key, static_cast<size_t>(len), kHash.seed) & (kTableSize - 1)];
+        if (k < 0 || kKeyLengths[static_cast<size_t>(k)] != static_cast<size_t>(len)) return -1;
+        for (int i = 0; i < len; ++i) {
+            if (Schema::keys[k].name[i] != key[i]) return -1;
+        }
+        return k;
+    }
+};
+
+// Felder eines Objekts (Cursor steht hinter '{') in record
+template <class T> bool decodeFields(RecordCursor& cursor, T& record) {
+    using Tables = SchemaTables<T>;
+    uint64_t canonicalSeen = 0;
+    const char* key = nullptr;
+    int len = 0;
+    RecordScalar value;
+    while (cursor.nextKey(key, len)) {
+        const int k = Tables::lookup(key, len);
+        if (!cursor.readValue(value)) return false;
+        if (k < 0) continue;
+        const RecordKey& entry = RecordSchema<T>::keys[k];
+        const uint64_t bit = uint64_t(1) << entry.field;
+        if (entry.alias) {
+            if (canonicalSeen & bit) continue;
+        } else {
+            canonicalSeen |= bit;
+        }
+        if (!Tables::kSetters[static_cast<size_t>(entry.field)](record, value)) return false;
+    }
+    return !cursor.failed();
+}
+
+// Zustand eines CBOR Records für readCborField: kanonisch-vor-Alias Bitmaske und der zuletzt gelesene Wert
+struct CborRecordState {
+    uint64_t canonicalSeen = 0;
+    RecordScalar value;
+    QByteArray storage;
+    int field = -1; // Feld des letzten Keys; -1 = unbekannter Key oder Alias hinter dem kanonischen Key
+};
+
+// CBOR Map-Key über dieselbe Tabelle; Schema-Keys sind kurzes ASCII, alles andere ist unbekannt
+template <class T> int lookupKey(const QString& key) {
+    char name[64];
+    const int len = static_cast<int>(key.size());
+    if (len > int(sizeof(name))) return -1;
+    for (int i = 0; i < len; ++i) {
+        const ushort c = key.at(i).unicode();
+        if (c >= 0x80) return -1;
+        name[i] = char(c);
+    }
+    return SchemaTables<T>::lookup(name, len);
+}
+
+// Wert zu key (readMap/forEachRecord Callback) konsumieren und wie decodeFields über den Setter schreiben.
+// false wenn der Setter ablehnt (Text-t bei Kerzen); state.value hält dann den Wert für den Aufrufer
+template <class T> bool readCborField(CborReader& reader, const QString& key, T& record, CborRecordState& state) {
+    state.field = -1;
+    const int k = lookupKey<T>(key);
+    if (k < 0) { reader.skip(); return true; }
+    const RecordKey& entry = RecordSchema<T>::keys[k];
+    const uint64_t bit = uint64_t(1) << entry.field;
+    if (entry.alias) {
+        if (state.canonicalSeen & bit) { reader.skip(); return true; }
+    } else {
+        state.canonicalSeen |= bit;
+    }
+    scalarFromCbor(reader, state.value, state.storage);
+    state.field = entry.field;
+    return SchemaTables<T>::kSetters[static_cast<size_t>(entry.field)](record, state.value);
+}
+
+// Alle Schema-Felder gleich (Zeilen-Abgleich der Listen-Models)
+template <class T> bool recordsEqual(const T& a, const T& b) {
+    return std::apply([&](auto... members) { return ((a.*members == b.*members) && ...); }, RecordSchema<T>::fields);
+}
+
+// Wert eines Feldes im DOM Objekt: kanonischer Key, sonst ein vorhandener Alias (Undefined wenn keiner)
+template <class T> QJsonValue jsonField(const QJsonObject& object, int field) {
+    QJsonValue alias(QJsonValue::Undefined);
+    for (const RecordKey& key : RecordSchema<T>::keys) {
+        if (key.field != field) continue;
+        const QJsonValue v = object.value(QLatin1String(key.name));
+        if (v.isUndefined()) continue;
+        if (!key.alias) return v;
+        if (alias.isUndefined()) alias = v;
+    }
+    return alias;
+}
+
+} // namespace RecordDecoding
+
+namespace RecordDecoder {
+
+// JSON Array von Objekten -> out (vorher geleert, vorab reserviert). false: Aufrufer fällt auf LenientJson zurück
+template <class T> bool decodeArray(const QByteArray& bytes, QVector<T>& out) {
+    RecordCursor cursor(bytes.constData(), static_cast<size_t>(bytes.size()));
+    out.clear();
+    if (!cursor.enterArray()) return false;
+    out.reserve(cursor.estimateRecords());
+    while (cursor.nextRecord()) {
+        T record {};
+        if (!RecordDecoding::decodeFields(cursor, record)) return false;
+        out.push_back(std::move(record));
+    }
+    return !cursor.failed() && cursor.atEnd();
+}
+
+// DOM Objekt (LenientJson Fallback) über dieselben Keys und Setter wie decodeFields; Felder die nicht vorkommen
+// bleiben unverändert. false wenn ein Setter den Wert ablehnt (Text-t bei Kerzen), die übrigen Felder sind dann gesetzt
+template <class T> bool decodeJsonObject(const QJsonObject& object, T& record) {
+    using Tables = RecordDecoding::SchemaTables<T>;
+    bool ok = true;
+    QByteArray storage;
+    RecordScalar value;
+    for (size_t field = 0; field < Tables::kFieldCount; ++field) {
+        const QJsonValue v = RecordDecoding::jsonField<T>(object, static_cast<int>(field));
+        if (v.isUndefined()) continue;
+        RecordDecoding::scalarFromJson(v, value, storage);
+        if (!Tables::kSetters[field](record, value)) ok = false;
+    }
+    return ok;
+}
+
+// DOM Array von Objekten -> out (Nicht-Objekte werden übersprungen)
+template <class T> void decodeJsonArray(const QJsonArray& array, QVector<T>& out) {
+    QVector<T> rows;
+    rows.reserve(array.size());
+    for (const QJsonValue v : array) {
+        if (!v.isObject()) continue;
+        T record {};
+        decodeJsonObject(v.toObject(), record);
+        rows.push_back(std::move(record));
+    }
+    out = std::move(rows);
+}
+
+// Einzelnes JSON Objekt; Felder die nicht vorkommen bleiben unverändert
+template <class T> bool decodeObject(const QByteArray& bytes, T& out) {
+    RecordCursor cursor(bytes.constData(), static_cast<size_t>(bytes.size()));
+    if (!cursor.enterObject()) return false;
+    T record = out;
+    if (!RecordDecoding::decodeFields(cursor, record) || !cursor.atEnd()) return false;
+    out = std::move(record);
+    return true;
+}
+
+// CBOR Array von Maps -> out (Keys, Aliase und Setter wie decodeArray); false bei kaputtem CBOR oder abgelehntem Wert
+template <class T> bool decodeCborArray(const QByteArray& bytes, QVector<T>& out) {
+    CborReader reader(bytes);
+    QVector<T> rows;
+    T record {};
+    RecordDecoding::CborRecordState state;
+    bool accepted = true;
+    const bool ok = reader.forEachRecord([&](const QString& key) {
+        if (!RecordDecoding::readCborField(reader, key, record, state)) accepted = false;
+    }, [&] {
+        rows.push_back(std::move(record));
+        record = T {};
+        state.canonicalSeen = 0;
+    });
+    if (!ok || !accepted) return false;
+    out = std::move(rows);
+    return true;
+}
+
+} // namespace RecordDecoder
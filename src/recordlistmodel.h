@@ -0,0 +1,47 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QVector>
+#include <algorithm>
+#include "recorddecoder.h"
+
+// Listen-Model über Records mit RecordSchema (Portfolio, Orders, Notifications).
+// setRows() gleicht zeilenweise ab statt das Model zurückzusetzen: gleicher Anfang und gleiches Ende bleiben unberührt,
+// dazwischen ein dataChanged plus ein Insert bzw. Remove. ListView behält so Delegates und Scroll-Position,
+// eine neue Notification oben ist ein einzelnes rowsInserted.
+template <class Row> class RecordListModel : public QAbstractListModel {
+public:
+    using QAbstractListModel::QAbstractListModel;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override { return parent.isValid() ? 0 : int(m_rows.size()); }
+
+    // Apply-Stufe im GUI Thread (rows aus der Decode-Stufe)
+    void setRows(const QVector<Row>& rows) {
+        const int oldCount = int(m_rows.size());
+        const int newCount = int(rows.size());
+        int prefix = 0;
+        while (prefix < oldCount && prefix < newCount && RecordDecoding::recordsEqual(m_rows.at(prefix), rows.at(prefix))) ++prefix;
+        int suffix = 0;
+        while (suffix < oldCount - prefix && suffix < newCount - prefix
+               && RecordDecoding::recordsEqual(m_rows.at(oldCount - 1 - suffix), rows.at(newCount - 1 - suffix))) ++suffix;
+        const int oldMid = oldCount - prefix - suffix;
+        const int newMid = newCount - prefix - suffix;
+        const int common = std::min(oldMid, newMid);
+        // Inhalt danach identisch zu rows: implizit geteilt übernehmen, die Signale beschreiben nur den Unterschied.
+        // Die geänderten Zeilen liegen vor der Insert/Remove-Position, ihre Indizes gelten vorher wie nachher.
+        if (newMid > oldMid) {
+            beginInsertRows(QModelIndex(), prefix + common, prefix + newMid - 1);
+            m_rows = rows;
+            endInsertRows();
+        } else if (oldMid > newMid) {
+            beginRemoveRows(QModelIndex(), prefix + common, prefix + oldMid - 1);
+            m_rows = rows;
+            endRemoveRows();
+        } else {
+            m_rows = rows;
+        }
+        if (common > 0) emit dataChanged(index(prefix), index(prefix + common - 1));
+    }
+
+protected:
+    QVector<Row> m_rows;
+};
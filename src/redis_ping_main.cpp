@@ -1,7 +1,21 @@
 #include <iostream>
+#include <chrono>
 #include <cstdlib>
 #include "redisclient.h"
 
+namespace {
+// Mittlere PING Round-Trip Zeit in us (-1 bei Fehler)
+long long pingRoundTripUs(RedisClient& client, int rounds) {
+    if (!client.ping()) return -1; // Connect + Warmup
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        if (!client.ping()) return -1;
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    return us / rounds;
+}
+}
+
 int main() {
     const char* hostEnv = std::getenv("REDIS_HOST");
     const char* portEnv = std::getenv("REDIS_PORT");
@@ -14,5 +28,34 @@ int main() {
     }
     bool ok = client.ping();
     std::cout << (ok?"PING ok":"PING failed") << " for " << host << ":" << port << "\n";
+    // Optional: GET Durchsatz für einen (großen) Key messen, z.B. REDIS_BENCH_KEY=chart_data_AAPL
+    const char* benchKey = std::getenv("REDIS_BENCH_KEY");
+    if (ok && benchKey) {
+        const int rounds = 200;
+        size_t bytes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            auto val = client.get(benchKey);
+            if (val) bytes += static_cast<size_t>(val->size());
+        }
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "GET " << benchKey << ": " << rounds << " rounds, " << (bytes / rounds) << " bytes, "
+                  << (us / rounds) << " us/GET\n";
+    }
+    // Optional: TCP vs. Unix Socket vergleichen, z.B. REDIS_UNIX_SOCKET=/var/run/redis/redis.sock
+    const char* unixSocket = std::getenv("REDIS_UNIX_SOCKET");
+    if (ok && unixSocket) {
+        const int rounds = 1000;
+        RedisClient tcpClient(client.isUnixSocket() ? "127.0.0.1" : host, port, 0, "");
+        RedisClient unixClient(std::string("unix:") + unixSocket, 0, 0, "");
+        long long tcpUs = pingRoundTripUs(tcpClient, rounds);
+        long long unixUs = pingRoundTripUs(unixClient, rounds);
+        if (tcpUs < 0 || unixUs < 0) {
+            std::cerr << "Transport comparison failed (" << (tcpUs < 0 ? "tcp" : "unix") << ")\n";
+            return 3;
+        }
+        std::cout << "PING tcp: " << tcpUs << " us, unix: " << unixUs << " us, diff: " << (tcpUs - unixUs)
+                  << " us/RTT (" << rounds << " rounds)\n";
+    }
     return ok?0:2;
 }
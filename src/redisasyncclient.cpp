@@ -0,0 +1,342 @@
+// Asynchroner Redis Client Implementation (hiredis async + Qt Adapter, oder Stub bei REDIS_STUB)
+#include "redisasyncclient.h"
+#include <QDebug>
+#include <algorithm>
+#include <memory>
+
+#ifndef REDIS_STUB
+#if defined(HIREDIS_VENDORED)
+#include <hiredis.h>
+#include <async.h>
+#include <adapters/qt.h>
+#else
+#include <hiredis/hiredis.h>
+#include <hiredis/async.h>
+#include <hiredis/adapters/qt.h>
+#endif
+#endif
+
+RedisAsyncClient::RedisAsyncClient(const std::string& host, int port, int db, const std::string& password, QObject* parent)
+    : QObject(parent), m_host(host), m_port(port), m_db(db), m_password(password) {
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, [this]() { if (m_active && !m_ctx) startConnect(); });
+    m_timeoutTimer.setSingleShot(true);
+#ifndef REDIS_STUB
+    m_adapter = new RedisQtAdapter(this);
+    // hiredis ruft ev.scheduleTimer bei jedem Lese-/Schreibwunsch; läuft der Timer ab, prüft
+    // redisAsyncHandleTimeout ob noch Replies ausstehen (Connect- bzw. Command-Timeout)
+    connect(&m_timeoutTimer, &QTimer::timeout, this, [this]() { if (m_ctx) redisAsyncHandleTimeout(m_ctx); });
+#endif
+}
+
+RedisAsyncClient::~RedisAsyncClient() {
+    m_closing = true;
+    m_active = false;
+    dropContext();
+}
+
+void RedisAsyncClient::connectToServer() {
+    m_active = true;
+    if (m_ctx) return;
+    startConnect();
+}
+
+void RedisAsyncClient::disconnectFromServer() {
+    m_active = false;
+    m_reconnectTimer.stop();
+    dropContext();
+}
+
+void RedisAsyncClient::dropContext() {
+#ifndef REDIS_STUB
+    if (!m_ctx) return;
+    redisAsyncContext* ac = m_ctx;
+    m_ctx = nullptr;
+    m_timeoutTimer.stop();
+    // Ausstehende Callbacks bekommen nullptr; onDisconnect sieht m_ctx == nullptr und plant keinen Reconnect
+    redisAsyncFree(ac);
+#endif
+    setReady(false);
+}
+
+#ifndef REDIS_STUB
+void redisAsyncClientArmTimeout(RedisAsyncClient* self, int ms) {
+    self->m_timeoutTimer.start(ms);
+}
+
+static void qtScheduleTimer(void* adapter, struct timeval tv) {
+    auto* client = qobject_cast<RedisAsyncClient*>(static_cast<RedisQtAdapter*>(adapter)->parent());
+    if (client) redisAsyncClientArmTimeout(client, static_cast<int>(tv.tv_sec * 1000 + tv.tv_usec / 1000));
+}
+#endif
+
+void RedisAsyncClient::startConnect() {
+#ifdef REDIS_STUB
+    emit errorOccurred(QStringLiteral("Redis stub mode - no live connection"));
+#else
+    if (m_ctx) return;
+    struct timeval connectTv = { m_connectTimeoutMs / 1000, (m_connectTimeoutMs % 1000) * 1000 };
+    struct timeval commandTv = { m_commandTimeoutMs / 1000, (m_commandTimeoutMs % 1000) * 1000 };
+    redisOptions opts = {};
+    // "unix:/pfad/redis.sock" -> Unix Domain Socket (lokale Replica ohne Loopback TCP), sonst TCP
+    const std::string unixPath = m_host.rfind("unix:", 0) == 0 ? m_host.substr(5) : std::string();
+    if (!unixPath.empty()) {
+        REDIS_OPTIONS_SET_UNIX(&opts, unixPath.c_str());
+    } else {
+        REDIS_OPTIONS_SET_TCP(&opts, m_host.c_str(), m_port);
+    }
+    opts.connect_timeout = &connectTv;
+    opts.command_timeout = &commandTv;
+    redisAsyncContext* ac = redisAsyncConnectWithOptions(&opts);
+    if (!ac || ac->err) {
+        QString err = ac ? QString::fromUtf8(ac->errstr) : QStringLiteral("cannot allocate async context");
+        if (ac) redisAsyncFree(ac);
+        emit errorOccurred(err);
+        scheduleReconnect();
+        return;
+    }
+    ac->data = this;
+    m_ctx = ac;
+    m_adapter->setContext(ac);
+    ac->ev.scheduleTimer = qtScheduleTimer;
+    redisAsyncSetConnectCallback(ac, &RedisAsyncClient::onConnect);
+    redisAsyncSetDisconnectCallback(ac, &RedisAsyncClient::onDisconnect);
+
+    // Handshake direkt hinter den Connect pipelinen; hiredis puffert bis der Socket schreibbar ist
+    m_handshakePending = 0;
+    if (!m_password.empty()) {
+        ++m_handshakePending;
+        command({"AUTH", m_password}, [this](redisReply* r) { handshakeStep(r, "AUTH"); });
+    }
+    if (m_db != 0) {
+        ++m_handshakePending;
+        command({"SELECT", std::to_string(m_db)}, [this](redisReply* r) { handshakeStep(r, "SELECT"); });
+    }
+#endif
+}
+
+void RedisAsyncClient::handshakeStep(redisReply* reply, const char* what) {
+#ifndef REDIS_STUB
+    if (!reply) return; // Verbindung weg -> onDisconnect kümmert sich
+    if (reply->type == REDIS_REPLY_ERROR) {
+        emit errorOccurred(QStringLiteral("Redis %1 failed: %2").arg(QString::fromLatin1(what), QString::fromUtf8(reply->str, static_cast<int>(reply->len))));
+        // Nicht im Callback freigeben - hiredis erledigt das nach Rückkehr (REDIS_FREEING)
+        if (m_ctx) { redisAsyncDisconnect(m_ctx); }
+        return;
+    }
+    if (--m_handshakePending == 0 && m_ctx && (m_ctx->c.flags & REDIS_CONNECTED)) setReady(true);
+#else
+    Q_UNUSED(reply); Q_UNUSED(what);
+#endif
+}
+
+void RedisAsyncClient::setReady(bool ready) {
+    if (ready == m_ready) return;
+    m_ready = ready;
+    if (m_closing) return;
+    if (ready) {
+        m_reconnectDelayMs = m_minReconnectDelayMs;
+        resubscribeAll();
+        emit connected();
+    } else {
+        emit disconnected();
+    }
+}
+
+void RedisAsyncClient::scheduleReconnect() {
+    if (!m_active || m_closing || m_reconnectTimer.isActive()) return;
+    m_reconnectTimer.start(m_reconnectDelayMs);
+    // exponentieller Backoff bis max
+    m_reconnectDelayMs = std::min(m_reconnectDelayMs * 2, m_maxReconnectDelayMs);
+}
+
+void RedisAsyncClient::onConnect(const redisAsyncContext* ac, int status) {
+#ifndef REDIS_STUB
+    auto* self = static_cast<RedisAsyncClient*>(ac->data);
+    if (!self || self->m_ctx != ac) return;
+    if (status != REDIS_OK) {
+        // hiredis gibt den Kontext nach diesem Callback selbst frei
+        self->m_ctx = nullptr;
+        self->m_timeoutTimer.stop();
+        emit self->errorOccurred(QString::fromUtf8(ac->errstr));
+        self->scheduleReconnect();
+        return;
+    }
+    if (self->m_handshakePending == 0) self->setReady(true);
+#else
+    Q_UNUSED(ac); Q_UNUSED(status);
+#endif
+}
+
+void RedisAsyncClient::onDisconnect(const redisAsyncContext* ac, int status) {
+#ifndef REDIS_STUB
+    auto* self = static_cast<RedisAsyncClient*>(ac->data);
+    if (!self || self->m_ctx != ac) return; // gewollt über dropContext() getrennt
+    self->m_ctx = nullptr;
+    self->m_timeoutTimer.stop();
+    if (status != REDIS_OK) emit self->errorOccurred(QString::fromUtf8(ac->errstr));
+    self->setReady(false);
+    self->scheduleReconnect();
+#else
+    Q_UNUSED(ac); Q_UNUSED(status);
+#endif
+}
+
+void RedisAsyncClient::onReply(redisAsyncContext* ac, void* reply, void* privdata) {
+    std::unique_ptr<ReplyCallback> cb(static_cast<ReplyCallback*>(privdata));
+    auto* self = static_cast<RedisAsyncClient*>(ac->data);
+    if (!self || self->m_closing) return; // Destruktor: keine User-Callbacks mehr
+    if (*cb) (*cb)(static_cast<redisReply*>(reply));
+}
+
+bool RedisAsyncClient::command(const std::vector<std::string>& args, ReplyCallback cb) {
+#ifdef REDIS_STUB
+    if (cb) cb(nullptr);
+    Q_UNUSED(args);
+    return false;
+#else
+    if (!m_ctx || args.empty()) { if (cb) cb(nullptr); return false; }
+    std::vector<const char*> argv;
+    std::vector<size_t> argvlen;
+    argv.reserve(args.size());
+    argvlen.reserve(args.size());
+    for (const auto& a : args) { argv.push_back(a.data()); argvlen.push_back(a.size()); }
+    auto* heapCb = new ReplyCallback(std::move(cb));
+    if (redisAsyncCommandArgv(m_ctx, &RedisAsyncClient::onReply, heapCb, static_cast<int>(args.size()), argv.data(), argvlen.data()) != REDIS_OK) {
+        std::unique_ptr<ReplyCallback> owned(heapCb);
+        if (*owned) (*owned)(nullptr);
+        return false;
+    }
+    return true;
+#endif
+}
+
+void RedisAsyncClient::ping(std::function<void(bool ok)> cb) {
+    command({"PING"}, [cb = std::move(cb)](redisReply* reply) {
+#ifndef REDIS_STUB
+        cb(reply && (reply->type == REDIS_REPLY_STATUS || reply->type == REDIS_REPLY_STRING));
+#else
+        Q_UNUSED(reply); cb(false);
+#endif
+    });
+}
+
+void RedisAsyncClient::get(const std::string& key, std::function<void(std::optional<std::string>)> cb) {
+    command({"GET", key}, [cb = std::move(cb)](redisReply* reply) {
+#ifndef REDIS_STUB
+        if (reply && reply->type == REDIS_REPLY_STRING) { cb(std::string(reply->str, reply->len)); return; }
+#else
+        Q_UNUSED(reply);
+#endif
+        cb(std::nullopt);
+    });
+}
+
+void RedisAsyncClient::pipelineGet(const std::vector<std::string>& keys, ValuesCallback cb) {
+    struct Batch {
+        std::vector<std::optional<QByteArray>> values;
+        size_t remaining = 0;
+        bool ok = true;
+        ValuesCallback cb;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->values.resize(keys.size());
+    batch->remaining = keys.size() + 1;
+    batch->cb = std::move(cb);
+    auto finish = [batch]() {
+        if (--batch->remaining == 0) batch->cb(batch->ok, std::move(batch->values));
+    };
+    ping([batch, finish](bool ok) { if (!ok) batch->ok = false; finish(); });
+    for (size_t i = 0; i < keys.size(); ++i) {
+        command({"GET", keys[i]}, [batch, finish, i](redisReply* reply) {
+#ifndef REDIS_STUB
+            if (!reply) batch->ok = false;
+            else if (reply->type == REDIS_REPLY_STRING) batch->values[i].emplace(reply->str, static_cast<qsizetype>(reply->len));
+#else
+            Q_UNUSED(reply); Q_UNUSED(i);
+            batch->ok = false;
+#endif
+            finish();
+        });
+    }
+}
+
+void RedisAsyncClient::subscribe(const std::vector<std::string>& channels, MessageCallback cb) {
+    std::vector<std::string> fresh;
+    for (const auto& ch : channels) {
+        if (m_channelSubs.find(ch) == m_channelSubs.end()) fresh.push_back(ch);
+        m_channelSubs[ch] = cb;
+    }
+    if (m_ready && !fresh.empty()) sendSubscription("SUBSCRIBE", fresh);
+}
+
+void RedisAsyncClient::unsubscribe(const std::vector<std::string>& channels) {
+    std::vector<std::string> known;
+    for (const auto& ch : channels) {
+        if (m_channelSubs.erase(ch) > 0) known.push_back(ch);
+    }
+    if (m_ready && !known.empty()) sendSubscription("UNSUBSCRIBE", known);
+}
+
+void RedisAsyncClient::psubscribe(const std::vector<std::string>& patterns, MessageCallback cb) {
+    std::vector<std::string> fresh;
+    for (const auto& p : patterns) {
+        if (m_patternSubs.find(p) == m_patternSubs.end()) fresh.push_back(p);
+        m_patternSubs[p] = cb;
+    }
+    if (m_ready && !fresh.empty()) sendSubscription("PSUBSCRIBE", fresh);
+}
+
+void RedisAsyncClient::punsubscribe(const std::vector<std::string>& patterns) {
+    std::vector<std::string> known;
+    for (const auto& p : patterns) {
+        if (m_patternSubs.erase(p) > 0) known.push_back(p);
+    }
+    if (m_ready && !known.empty()) sendSubscription("PUNSUBSCRIBE", known);
+}
+
+void RedisAsyncClient::resubscribeAll() {
+    std::vector<std::string> names;
+    for (const auto& entry : m_channelSubs) names.push_back(entry.first);
+    if (!names.empty()) sendSubscription("SUBSCRIBE", names);
+    names.clear();
+    for (const auto& entry : m_patternSubs) names.push_back(entry.first);
+    if (!names.empty()) sendSubscription("PSUBSCRIBE", names);
+}
+
+void RedisAsyncClient::sendSubscription(const char* verb, const std::vector<std::string>& names) {
+#ifdef REDIS_STUB
+    Q_UNUSED(verb); Q_UNUSED(names);
+#else
+    if (!m_ctx) return;
+    std::vector<const char*> argv { verb };
+    std::vector<size_t> argvlen { std::char_traits<char>::length(verb) };
+    for (const auto& n : names) { argv.push_back(n.data()); argvlen.push_back(n.size()); }
+    // hiredis hält den Callback pro Kanal/Pattern, privdata ist der Client selbst (kein Heap-Objekt)
+    redisAsyncCommandArgv(m_ctx, &RedisAsyncClient::onSubscriptionReply, this, static_cast<int>(argv.size()), argv.data(), argvlen.data());
+#endif
+}
+
+void RedisAsyncClient::onSubscriptionReply(redisAsyncContext* ac, void* r, void* privdata) {
+#ifndef REDIS_STUB
+    auto* self = static_cast<RedisAsyncClient*>(privdata);
+    auto* reply = static_cast<redisReply*>(r);
+    if (!self || self->m_closing || !reply || ac->data != self) return;
+    if ((reply->type != REDIS_REPLY_ARRAY && reply->type != REDIS_REPLY_PUSH) || reply->elements < 3) return;
+    auto str = [reply](size_t i) {
+        const redisReply* e = reply->element[i];
+        return (e && e->str) ? std::string(e->str, e->len) : std::string();
+    };
+    const std::string kind = str(0);
+    if (kind == "message") {
+        auto it = self->m_channelSubs.find(str(1));
+        if (it != self->m_channelSubs.end() && it->second) it->second(str(1), str(2));
+    } else if (kind == "pmessage" && reply->elements >= 4) {
+        auto it = self->m_patternSubs.find(str(1));
+        if (it != self->m_patternSubs.end() && it->second) it->second(str(2), str(3));
+    }
+    // subscribe/unsubscribe Bestätigungen ignorieren
+#else
+    Q_UNUSED(ac); Q_UNUSED(r); Q_UNUSED(privdata);
+#endif
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct redisAsyncContext; // forward from hiredis
+struct redisReply;
+class RedisQtAdapter;
+
+// Asynchroner Redis Client auf dem Qt Event Loop (hiredis async.c + adapters/qt.h).
+// Connect, AUTH, SELECT, Kommandos und Reconnect laufen komplett über Callbacks,
+// der GUI Thread blockiert nie auf einem Socket.
+class RedisAsyncClient : public QObject {
+    Q_OBJECT
+public:
+    // reply == nullptr bei Verbindungsabbruch / Timeout; Reply ist nur während des Callbacks gültig
+    using ReplyCallback = std::function<void(redisReply* reply)>;
+    using ValuesCallback = std::function<void(bool ok, std::vector<std::optional<QByteArray>> values)>;
+    // Pub/Sub Nachricht (bei PSUBSCRIBE ist channel der konkrete Kanal, nicht das Pattern)
+    using MessageCallback = std::function<void(const std::string& channel, const std::string& payload)>;
+
+    explicit RedisAsyncClient(const std::string& host = "127.0.0.1", int port = 6380, int db = 0,
+                              const std::string& password = "", QObject* parent = nullptr);
+    ~RedisAsyncClient() override;
+
+    void setHost(const std::string& h) { if (h != m_host) { m_host = h; reconnectIfActive(); } }
+    void setPort(int p) { if (p != m_port) { m_port = p; reconnectIfActive(); } }
+    void setPassword(const std::string& pw) { if (pw != m_password) { m_password = pw; reconnectIfActive(); } }
+    void setConnectTimeoutMs(int ms) { m_connectTimeoutMs = ms; }
+    void setCommandTimeoutMs(int ms) { m_commandTimeoutMs = ms; }
+
+    // true sobald TCP verbunden und AUTH/SELECT bestätigt sind
+    bool isConnected() const { return m_ready; }
+
+    // Startet den (asynchronen) Verbindungsaufbau; bei Abbruch wird automatisch mit Backoff neu verbunden
+    void connectToServer();
+    void disconnectFromServer();
+
+    // Beliebiges Kommando (binary safe). false wenn keine Verbindung besteht (cb wird dann mit nullptr gerufen)
+    bool command(const std::vector<std::string>& args, ReplyCallback cb);
+    void ping(std::function<void(bool ok)> cb);
+    void get(const std::string& key, std::function<void(std::optional<std::string>)> cb);
+    // PING + GET für alle Keys; hiredis sendet alles in einem Write, cb feuert nach der letzten Reply
+    void pipelineGet(const std::vector<std::string>& keys, ValuesCallback cb);
+
+    // Subscriptions werden gemerkt und nach jedem Reconnect automatisch erneuert.
+    // Achtung: eine Verbindung mit aktiven Subscriptions akzeptiert (RESP2) keine normalen Kommandos mehr.
+    void subscribe(const std::vector<std::string>& channels, MessageCallback cb);
+    void unsubscribe(const std::vector<std::string>& channels);
+    void psubscribe(const std::vector<std::string>& patterns, MessageCallback cb);
+    void punsubscribe(const std::vector<std::string>& patterns);
+
+signals:
+    void connected();
+    void disconnected();
+    void errorOccurred(const QString& message);
+
+private:
+    std::string m_host;
+    int m_port;
+    int m_db;
+    std::string m_password;
+    redisAsyncContext* m_ctx {nullptr};
+    RedisQtAdapter* m_adapter {nullptr};
+    bool m_active {false};   // connectToServer() aufgerufen (Reconnect erwünscht)
+    bool m_ready {false};
+    bool m_closing {false};
+    int m_handshakePending {0};
+    int m_connectTimeoutMs {3000};
+    int m_commandTimeoutMs {3000};
+    // Reconnect Backoff
+    QTimer m_reconnectTimer;
+    QTimer m_timeoutTimer;
+    int m_reconnectDelayMs {500};
+    int m_minReconnectDelayMs {500};
+    int m_maxReconnectDelayMs {30000};
+    std::map<std::string, MessageCallback> m_channelSubs;
+    std::map<std::string, MessageCallback> m_patternSubs;
+
+    void startConnect();
+    void dropContext();
+    void reconnectIfActive() { if (m_active) { dropContext(); startConnect(); } }
+    void scheduleReconnect();
+    void handshakeStep(redisReply* reply, const char* what);
+    void setReady(bool ready);
+    void sendSubscription(const char* verb, const std::vector<std::string>& names);
+    void resubscribeAll();
+
+    static void onConnect(const redisAsyncContext* ac, int status);
+    static void onDisconnect(const redisAsyncContext* ac, int status);
+    static void onReply(redisAsyncContext* ac, void* reply, void* privdata);
+    static void onSubscriptionReply(redisAsyncContext* ac, void* reply, void* privdata);
+    friend void redisAsyncClientArmTimeout(RedisAsyncClient* self, int ms);
+};
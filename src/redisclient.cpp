@@ -1,6 +1,9 @@
 // Redis Client Implementation (real or stub depending on REDIS_STUB)
 #include "redisclient.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 
 #ifndef REDIS_STUB
 #if defined(HIREDIS_VENDORED)
@@ -8,8 +11,126 @@
 #else
 #include <hiredis/hiredis.h>
 #endif
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
 #endif
 
+namespace {
+// Reply-Objekt für Werte-Pfade: hiredis ruft die redisReplyObjectFunctions direkt mit dem Zeiger in seinen
+// Read-Buffer auf, Bulk Strings landen so mit genau einer Kopie in einem QByteArray (statt Reader -> redisReply::str
+// -> std::string -> QByteArray). type muss erstes Member sein: hiredis erkennt RESP3 Pushes über
+// ((redisReply*)obj)->type, unabhängig von den Objekt-Funktionen.
+struct QtReply {
+    int type;
+    long long integer {0};
+    QByteArray str;
+    std::vector<QtReply*> element;
+    explicit QtReply(int t) : type(t) {}
+    ~QtReply() { for (auto* e : element) delete e; }
+    QtReply(const QtReply&) = delete;
+    QtReply& operator=(const QtReply&) = delete;
+};
+using QtReplyPtr = std::unique_ptr<QtReply>;
+
+void* qtAttach(const redisReadTask* task, QtReply* r) {
+    if (r && task->parent) static_cast<QtReply*>(task->parent->obj)->element[task->idx] = r;
+    return r;
+}
+
+void* qtCreateString(const redisReadTask* task, char* str, size_t len) {
+    auto* r = new (std::nothrow) QtReply(task->type);
+    if (!r) return nullptr;
+    if (task->type == REDIS_REPLY_VERB && len >= 4) { str += 4; len -= 4; } // "txt:" Header überspringen
+    r->str = QByteArray(str, static_cast<qsizetype>(len));
+    return qtAttach(task, r);
+}
+
+void* qtCreateArray(const redisReadTask* task, size_t elements) {
+    auto* r = new (std::nothrow) QtReply(task->type);
+    if (!r) return nullptr;
+    r->element.assign(elements, nullptr);
+    return qtAttach(task, r);
+}
+
+void* qtCreateInteger(const redisReadTask* task, long long value) {
+    auto* r = new (std::nothrow) QtReply(task->type);
+    if (!r) return nullptr;
+    r->integer = value;
+    return qtAttach(task, r);
+}
+
+void* qtCreateDouble(const redisReadTask* task, double, char* str, size_t len) {
+    auto* r = new (std::nothrow) QtReply(task->type);
+    if (!r) return nullptr;
+    r->str = QByteArray(str, static_cast<qsizetype>(len));
+    return qtAttach(task, r);
+}
+
+void* qtCreateNil(const redisReadTask* task) {
+    return qtAttach(task, new (std::nothrow) QtReply(REDIS_REPLY_NIL));
+}
+
+void* qtCreateBool(const redisReadTask* task, int bval) {
+    auto* r = new (std::nothrow) QtReply(task->type);
+    if (!r) return nullptr;
+    r->integer = bval != 0;
+    return qtAttach(task, r);
+}
+
+void qtFreeObject(void* obj) { delete static_cast<QtReply*>(obj); }
+
+redisReplyObjectFunctions kQtReplyFunctions = {
+    qtCreateString, qtCreateArray, qtCreateInteger, qtCreateDouble, qtCreateNil, qtCreateBool, qtFreeObject
+};
+
+// Schaltet den Reader für die Dauer des Scopes auf QtReply um. Nur zwischen vollständigen Replies umschalten
+// (dann existiert kein halb gebautes Objekt). Überlebt freeContext(): restauriert nur den eigenen Reader.
+class QtReaderScope {
+public:
+    explicit QtReaderScope(redisContext* const& ctx) : m_ctx(ctx), m_reader(ctx->reader), m_old(ctx->reader->fn) {
+        m_reader->fn = &kQtReplyFunctions;
+    }
+    ~QtReaderScope() { release(); }
+    void release() {
+        if (m_reader && m_ctx && m_ctx->reader == m_reader) m_reader->fn = m_old;
+        m_reader = nullptr;
+    }
+private:
+    redisContext* const& m_ctx;
+    redisReader* m_reader;
+    redisReplyObjectFunctions* m_old;
+};
+
+QtReplyPtr qtGetReply(redisContext* c) {
+    void* reply = nullptr;
+    if (redisGetReply(c, &reply) != REDIS_OK) return nullptr;
+    return QtReplyPtr(static_cast<QtReply*>(reply));
+}
+} // namespace
+#endif
+
+// Pro Key zwei Elemente: Digest ("" = fehlt) und Wert (nil = unverändert bzw. fehlt).
+// pcall: ein Key mit falschem Typ soll nicht den ganzen Batch scheitern lassen.
+static const char* kDigestScript = R"LUA(
+local out = {}
+for i, key in ipairs(KEYS) do
+  local v = redis.pcall('GET', key)
+  if type(v) ~= 'string' then
+    out[i*2-1] = ''
+    out[i*2] = false
+  else
+    local d = redis.sha1hex(v)
+    out[i*2-1] = d
+    if d == ARGV[i] then out[i*2] = false else out[i*2] = v end
+  end
+end
+return out
+)LUA";
+
 RedisClient::RedisClient(const std::string& host, int port, int db, const std::string& password)
     : m_host(host), m_port(port), m_db(db), m_password(password) {}
 
@@ -21,6 +142,9 @@ void RedisClient::freeContext() {
 #else
     m_ctx = nullptr;
 #endif
+    // Ohne Verbindung kommen keine Invalidierungen mehr an -> Cache ist nicht mehr vertrauenswürdig
+    m_trackingActive = false;
+    m_cache.clear();
 }
 
 bool RedisClient::connect() {
@@ -29,12 +153,23 @@ bool RedisClient::connect() {
     return false; // signal no live data -> poller kann fallback verwenden
 #else
     if (m_ctx) return true;
-    m_ctx = redisConnect(m_host.c_str(), m_port);
+    if (m_timeoutMs > 0) {
+        const struct timeval tv = { m_timeoutMs / 1000, (m_timeoutMs % 1000) * 1000 };
+        m_ctx = isUnixSocket() ? redisConnectUnixWithTimeout(m_host.c_str() + 5, tv) : redisConnectWithTimeout(m_host.c_str(), m_port, tv);
+        if (m_ctx && !m_ctx->err) redisSetTimeout(m_ctx, tv);
+    } else {
+        m_ctx = isUnixSocket() ? redisConnectUnix(m_host.c_str() + 5) : redisConnect(m_host.c_str(), m_port);
+    }
     if (!m_ctx || m_ctx->err) {
         std::cerr << "Redis connect error: " << (m_ctx ? m_ctx->errstr : "unknown") << std::endl;
         freeContext();
         return false;
     }
+    if (!isUnixSocket() && !applySocketOptions()) {
+        std::cerr << "Redis socket options failed: " << m_ctx->errstr << std::endl;
+        freeContext();
+        return false;
+    }
     if (!m_password.empty()) {
         if (!authIfNeeded()) return false;
     }
@@ -48,10 +183,182 @@ bool RedisClient::connect() {
         }
         freeReplyObject(reply);
     }
+    if (m_trackingWanted && !enableTracking()) {
+        std::cerr << "Redis client tracking unavailable, continuing without local cache" << std::endl;
+    }
+    return m_ctx != nullptr;
+#endif
+}
+
+bool RedisClient::applySocketOptions() {
+#ifdef REDIS_STUB
+    return true;
+#else
+    if (!m_socketOptions.tcpNoDelay) {
+        int no = 0;
+        if (setsockopt(m_ctx->fd, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no), sizeof(no)) != 0) return false;
+    }
+    if (m_socketOptions.keepAliveSec > 0 && redisEnableKeepAliveWithInterval(m_ctx, m_socketOptions.keepAliveSec) != REDIS_OK) {
+        return false;
+    }
+    if (m_socketOptions.recvBufferBytes > 0) {
+        int size = m_socketOptions.recvBufferBytes;
+        // Nur ein Hinweis an den Kernel (Linux verdoppelt, Cap über net.core.rmem_max) -> Fehler nicht fatal
+        if (setsockopt(m_ctx->fd, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&size), sizeof(size)) != 0) {
+            std::cerr << "Redis SO_RCVBUF not applied" << std::endl;
+        }
+    }
     return true;
 #endif
 }
 
+bool RedisClient::enableTracking() {
+#ifdef REDIS_STUB
+    return false;
+#else
+    redisReply* reply = (redisReply*)redisCommand(m_ctx, "HELLO 3");
+    if (!reply) { freeContext(); return false; }
+    bool ok = reply->type != REDIS_REPLY_ERROR;
+    freeReplyObject(reply);
+    if (!ok) return false; // Redis < 6: bleibt RESP2
+    m_ctx->privdata = this;
+    redisSetPushCallback(m_ctx, &RedisClient::onPush);
+    reply = (redisReply*)redisCommand(m_ctx, "CLIENT TRACKING ON");
+    if (!reply) { freeContext(); return false; }
+    ok = reply->type != REDIS_REPLY_ERROR;
+    freeReplyObject(reply);
+    m_trackingActive = ok;
+    return ok;
+#endif
+}
+
+void RedisClient::onPush(void* privdata, void* r) {
+#ifndef REDIS_STUB
+    auto* self = static_cast<RedisClient*>(privdata);
+    // ["invalidate", [key, ...]] bzw. ["invalidate", nil] nach FLUSHDB/FLUSHALL.
+    // Je nach aktivem Reader-Modus ist die Push-Reply ein redisReply oder ein QtReply.
+    std::vector<std::string> keys;
+    bool isInvalidate = false, flushAll = false;
+    if (self && self->m_ctx && self->m_ctx->reader->fn == &kQtReplyFunctions) {
+        QtReplyPtr reply(static_cast<QtReply*>(r));
+        if (reply->element.size() >= 2 && reply->element[0]->str == "invalidate") {
+            isInvalidate = true;
+            const QtReply* list = reply->element[1];
+            flushAll = list->type != REDIS_REPLY_ARRAY;
+            for (const QtReply* k : list->element) keys.push_back(k->str.toStdString());
+        }
+    } else {
+        auto* reply = static_cast<redisReply*>(r);
+        if (reply->elements >= 2 && reply->element[0]->str
+            && std::string(reply->element[0]->str, reply->element[0]->len) == "invalidate") {
+            isInvalidate = true;
+            const redisReply* list = reply->element[1];
+            flushAll = list->type != REDIS_REPLY_ARRAY;
+            for (size_t i = 0; !flushAll && i < list->elements; ++i) {
+                if (list->element[i]->str) keys.emplace_back(list->element[i]->str, list->element[i]->len);
+            }
+        }
+        freeReplyObject(reply); // Push-Callback besitzt die Reply
+    }
+    if (!self || !isInvalidate) return;
+    if (flushAll) {
+        self->m_stats.invalidations += self->m_cache.size();
+        self->m_cache.clear();
+        return;
+    }
+    for (const auto& k : keys) self->m_cache.erase(k);
+    self->m_stats.invalidations += keys.size();
+#else
+    (void)privdata; (void)r;
+#endif
+}
+
+void RedisClient::setMasterEndpoint(const std::string& host, int port, const std::string& password) {
+    m_replication = ReplicationStatus();
+    if (host.empty()) { m_master.reset(); return; }
+    // Remote: nie minutenlang im TCP Connect hängen; die Replica-Verbindung (dieser Client) genauso, sonst blockiert
+    // probeReplication() auf einer toten Replica den GUI Thread
+    constexpr int routingTimeoutMs = 2000;
+    if (m_timeoutMs == 0) setTimeoutMs(routingTimeoutMs);
+    m_master = std::make_unique<RedisClient>(host, port, m_db, password);
+    m_master->setTimeoutMs(m_timeoutMs);
+    m_master->setSocketOptions(m_socketOptions);
+    m_master->setClientTracking(m_trackingWanted);
+}
+
+std::optional<std::string> RedisClient::info(const char* section) {
+#ifdef REDIS_STUB
+    (void)section;
+    return std::nullopt;
+#else
+    if (!connect()) return std::nullopt;
+    redisReply* reply = (redisReply*)redisCommand(m_ctx, "INFO %s", section);
+    if (!reply) { freeContext(); return std::nullopt; }
+    std::optional<std::string> out;
+    // RESP3 (Tracking aktiv) liefert INFO als Verbatim String
+    if (reply->type == REDIS_REPLY_STRING || reply->type == REDIS_REPLY_VERB) out = std::string(reply->str, reply->len);
+    freeReplyObject(reply);
+    return out;
+#endif
+}
+
+namespace {
+// "name:value" Zeile aus INFO Text
+std::optional<std::string> infoField(const std::string& info, const std::string& name) {
+    size_t pos = 0;
+    while (pos < info.size()) {
+        size_t end = info.find('\n', pos);
+        if (end == std::string::npos) end = info.size();
+        if (info.compare(pos, name.size(), name) == 0 && pos + name.size() < end && info[pos + name.size()] == ':') {
+            size_t vEnd = end;
+            if (vEnd > pos && info[vEnd - 1] == '\r') --vEnd;
+            return info.substr(pos + name.size() + 1, vEnd - pos - name.size() - 1);
+        }
+        pos = end + 1;
+    }
+    return std::nullopt;
+}
+}
+
+bool RedisClient::probeReplication() {
+    ReplicationStatus st;
+    const std::optional<std::string> replicaInfo = info("replication");
+    long long replicaOffset = -1;
+    st.replicaUp = replicaInfo.has_value();
+    if (replicaInfo) {
+        const auto role = infoField(*replicaInfo, "role");
+        if (role && *role == "master") {
+            // Kein Replica-Setup (z.B. Entwicklung gegen einen einzelnen Server): immer frisch
+            st.linkUp = true;
+            st.lastIoSeconds = 0;
+        } else {
+            st.linkUp = infoField(*replicaInfo, "master_link_status").value_or("") == "up";
+            if (auto io = infoField(*replicaInfo, "master_last_io_seconds_ago")) st.lastIoSeconds = std::atoi(io->c_str());
+            if (auto off = infoField(*replicaInfo, "slave_repl_offset")) replicaOffset = std::atoll(off->c_str());
+        }
+    }
+    // Offset des Masters nur wenn ein Byte-Limit gesetzt ist (spart pro Poll einen Round-Trip zum Remote Master)
+    if (m_master && m_maxLagBytes > 0 && replicaOffset >= 0) {
+        if (auto masterInfo = m_master->info("replication")) {
+            if (auto off = infoField(*masterInfo, "master_repl_offset")) st.lagBytes = std::max(0LL, std::atoll(off->c_str()) - replicaOffset);
+        }
+    }
+    const bool stale = !st.replicaUp || !st.linkUp || st.lastIoSeconds < 0 || st.lastIoSeconds > m_maxLagSeconds
+                       || (m_maxLagBytes > 0 && st.lagBytes > m_maxLagBytes);
+    bool masterUp = false;
+    if (m_master && stale) masterUp = m_master->ping();
+    st.usingMaster = masterUp;
+    // Master nicht erreichbar: veraltete Daten der Replica sind besser als gar keine, als stale markieren
+    st.stale = stale && !masterUp && st.replicaUp;
+    if (st.usingMaster != m_replication.usingMaster || st.stale != m_replication.stale) {
+        std::cerr << "Redis reads now from " << (st.usingMaster ? "master" : (st.stale ? "stale replica" : "replica"))
+                  << " (link " << (st.linkUp ? "up" : "down") << ", last io " << st.lastIoSeconds << "s, lag " << st.lagBytes
+                  << " bytes)" << std::endl;
+    }
+    m_replication = st;
+    return st.usingMaster || st.replicaUp;
+}
+
 bool RedisClient::authIfNeeded() {
 #ifdef REDIS_STUB
     return false;
@@ -74,29 +381,234 @@ bool RedisClient::authIfNeeded() {
 }
 
 bool RedisClient::ping() {
+    if (readFromMaster()) return m_master->ping();
 #ifdef REDIS_STUB
     return false;
 #else
     if (!connect()) return false;
     redisReply* reply = (redisReply*)redisCommand(m_ctx, "PING");
-    if (!reply) return false;
+    if (!reply) { freeContext(); return false; } // Kontext ist nach I/O Fehler unbrauchbar -> reconnect beim nächsten Aufruf
     bool ok = (reply->type == REDIS_REPLY_STATUS || reply->type == REDIS_REPLY_STRING);
     freeReplyObject(reply);
     return ok;
 #endif
 }
 
-std::optional<std::string> RedisClient::get(const std::string& key) {
+std::optional<QByteArray> RedisClient::get(const std::string& key) {
+    if (readFromMaster()) return m_master->get(key);
 #ifdef REDIS_STUB
     return std::nullopt;
 #else
     if (!connect()) return std::nullopt;
-    redisReply* reply = (redisReply*)redisCommand(m_ctx, "GET %s", key.c_str());
-    if (!reply) return std::nullopt;
-    if (reply->type == REDIS_REPLY_NIL) { freeReplyObject(reply); return std::nullopt; }
-    if (reply->type != REDIS_REPLY_STRING) { freeReplyObject(reply); return std::nullopt; }
-    std::string val(reply->str, reply->len);
-    freeReplyObject(reply);
+    if (m_trackingActive) {
+        auto it = m_cache.find(key);
+        if (it != m_cache.end()) { ++m_stats.hits; return it->second; }
+        ++m_stats.misses;
+    }
+    if (redisAppendCommand(m_ctx, "GET %b", key.data(), key.size()) != REDIS_OK) { freeContext(); return std::nullopt; }
+    QtReaderScope qt(m_ctx);
+    QtReplyPtr reply = qtGetReply(m_ctx);
+    if (!reply) { freeContext(); return std::nullopt; }
+    std::optional<QByteArray> val;
+    if (reply->type == REDIS_REPLY_STRING) val = std::move(reply->str);
+    else if (reply->type != REDIS_REPLY_NIL) return std::nullopt;
+    if (m_trackingActive) m_cache[key] = val;
     return val;
 #endif
 }
+
+bool RedisClient::pipelineGet(const std::vector<std::string>& keys, std::vector<std::optional<QByteArray>>& values) {
+    if (readFromMaster()) return m_master->pipelineGet(keys, values);
+    values.assign(keys.size(), std::nullopt);
+#ifdef REDIS_STUB
+    return false;
+#else
+    if (!connect()) return false;
+    // Mit Tracking: nur Keys ohne Cache-Eintrag holen. Invalidierungen, die vor der PING Reply eintreffen,
+    // können gecachte Keys noch entfernen -> diese in einer zweiten Runde nachholen (selten).
+    std::vector<size_t> fetch;
+    fetch.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (m_trackingActive && m_cache.count(keys[i])) { ++m_stats.hits; continue; }
+        if (m_trackingActive) ++m_stats.misses;
+        fetch.push_back(i);
+    }
+    // Alles nur in den Output-Buffer schreiben; der erste redisGetReply flusht den kompletten Buffer
+    if (redisAppendCommand(m_ctx, "PING") != REDIS_OK) { freeContext(); return false; }
+    QtReaderScope qt(m_ctx);
+    bool pingOk = false;
+    for (int round = 0; round < 2; ++round) {
+        for (size_t i : fetch) {
+            if (redisAppendCommand(m_ctx, "GET %b", keys[i].data(), keys[i].size()) != REDIS_OK) { freeContext(); return false; }
+        }
+        const size_t expected = fetch.size() + (round == 0 ? 1 : 0);
+        for (size_t n = 0; n < expected; ++n) {
+            QtReplyPtr reply = qtGetReply(m_ctx);
+            if (!reply) {
+                std::cerr << "Redis pipeline error: " << (m_ctx ? m_ctx->errstr : "unknown") << std::endl;
+                freeContext();
+                return false;
+            }
+            if (round == 0 && n == 0) {
+                pingOk = (reply->type == REDIS_REPLY_STATUS || reply->type == REDIS_REPLY_STRING);
+                continue;
+            }
+            const size_t i = fetch[n - (round == 0 ? 1 : 0)];
+            if (reply->type == REDIS_REPLY_STRING) values[i] = std::move(reply->str); // implizit geteilt, keine Kopie
+            if (m_trackingActive && (reply->type == REDIS_REPLY_STRING || reply->type == REDIS_REPLY_NIL)) m_cache[keys[i]] = values[i];
+        }
+        if (!m_trackingActive) break;
+        // Gecachte Keys auflösen; inzwischen invalidierte nachladen
+        std::vector<size_t> missing;
+        std::vector<bool> fetched(keys.size(), false);
+        for (size_t i : fetch) fetched[i] = true;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (fetched[i]) continue;
+            auto it = m_cache.find(keys[i]);
+            if (it != m_cache.end()) values[i] = it->second;
+            else missing.push_back(i);
+        }
+        if (missing.empty()) break;
+        fetch.swap(missing);
+    }
+    return pingOk;
+#endif
+}
+
+bool RedisClient::zrangeByScore(const std::string& key, const std::string& min, const std::string& max,
+                                std::vector<std::pair<std::string, double>>& members) {
+    if (readFromMaster()) return m_master->zrangeByScore(key, min, max, members);
+    members.clear();
+#ifdef REDIS_STUB
+    return false;
+#else
+    if (!connect()) return false;
+    const char* argv[] = { "ZRANGEBYSCORE", key.c_str(), min.c_str(), max.c_str(), "WITHSCORES" };
+    const size_t argvlen[] = { 13, key.size(), min.size(), max.size(), 10 };
+    if (redisAppendCommandArgv(m_ctx, 5, argv, argvlen) != REDIS_OK) { freeContext(); return false; }
+    QtReaderScope qt(m_ctx);
+    QtReplyPtr reply = qtGetReply(m_ctx);
+    if (!reply) { freeContext(); return false; }
+    if (reply->type != REDIS_REPLY_ARRAY) return false;
+    // RESP2: flach member, score, ...; RESP3 (Tracking aktiv): [[member, score], ...]
+    members.reserve(reply->element.size());
+    for (size_t i = 0; i < reply->element.size(); ++i) {
+        const QtReply* e = reply->element[i];
+        if (e->type == REDIS_REPLY_ARRAY && e->element.size() == 2) {
+            const QtReply* score = e->element[1];
+            members.emplace_back(e->element[0]->str.toStdString(), score->type == REDIS_REPLY_DOUBLE || score->type == REDIS_REPLY_STRING ? score->str.toDouble() : 0.0);
+        } else if (i + 1 < reply->element.size()) {
+            members.emplace_back(e->str.toStdString(), reply->element[i + 1]->str.toDouble());
+            ++i;
+        }
+    }
+    return true;
+#endif
+}
+
+bool RedisClient::pipelineHmget(const std::vector<std::string>& keys, const std::vector<std::string>& fields,
+                                std::vector<std::vector<std::optional<QByteArray>>>& values) {
+    if (readFromMaster()) return m_master->pipelineHmget(keys, fields, values);
+    values.assign(keys.size(), std::vector<std::optional<QByteArray>>(fields.size()));
+#ifdef REDIS_STUB
+    return false;
+#else
+    if (keys.empty()) return true;
+    if (!connect()) return false;
+    std::vector<const char*> argv(2 + fields.size());
+    std::vector<size_t> argvlen(2 + fields.size());
+    argv[0] = "HMGET"; argvlen[0] = 5;
+    for (size_t j = 0; j < fields.size(); ++j) { argv[2 + j] = fields[j].data(); argvlen[2 + j] = fields[j].size(); }
+    for (const auto& key : keys) {
+        argv[1] = key.data(); argvlen[1] = key.size();
+        if (redisAppendCommandArgv(m_ctx, (int)argv.size(), argv.data(), argvlen.data()) != REDIS_OK) { freeContext(); return false; }
+    }
+    QtReaderScope qt(m_ctx);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        QtReplyPtr reply = qtGetReply(m_ctx);
+        if (!reply) { freeContext(); return false; }
+        if (reply->type != REDIS_REPLY_ARRAY) continue; // z.B. WRONGTYPE: Key überspringen
+        for (size_t j = 0; j < fields.size() && j < reply->element.size(); ++j) {
+            if (reply->element[j]->type == REDIS_REPLY_STRING) values[i][j] = std::move(reply->element[j]->str);
+        }
+    }
+    return true;
+#endif
+}
+
+bool RedisClient::loadDigestScript() {
+#ifdef REDIS_STUB
+    return false;
+#else
+    redisReply* reply = (redisReply*)redisCommand(m_ctx, "SCRIPT LOAD %s", kDigestScript);
+    if (!reply) { freeContext(); return false; }
+    bool ok = reply->type == REDIS_REPLY_STRING;
+    if (ok) m_digestSha.assign(reply->str, reply->len);
+    else std::cerr << "Redis SCRIPT LOAD failed: " << (reply->str ? reply->str : "") << std::endl;
+    freeReplyObject(reply);
+    return ok;
+#endif
+}
+
+bool RedisClient::pipelineGetIfChanged(const std::vector<std::string>& keys, std::vector<std::string>& digests,
+                                       std::vector<std::optional<QByteArray>>& values, std::vector<bool>& changed) {
+    if (readFromMaster()) return m_master->pipelineGetIfChanged(keys, digests, values, changed);
+    values.assign(keys.size(), std::nullopt);
+    changed.assign(keys.size(), false);
+    digests.resize(keys.size());
+#ifdef REDIS_STUB
+    return false;
+#else
+    if (!connect()) return false;
+    if (m_digestSha.empty() && !loadDigestScript()) return false;
+    const std::string numKeys = std::to_string(keys.size());
+    std::vector<const char*> argv;
+    std::vector<size_t> argvlen;
+    argv.reserve(3 + 2 * keys.size());
+    argvlen.reserve(3 + 2 * keys.size());
+    argv.push_back("EVALSHA"); argvlen.push_back(7);
+    argv.push_back(m_digestSha.data()); argvlen.push_back(m_digestSha.size());
+    argv.push_back(numKeys.data()); argvlen.push_back(numKeys.size());
+    for (const auto& k : keys) { argv.push_back(k.data()); argvlen.push_back(k.size()); }
+    for (const auto& d : digests) { argv.push_back(d.data()); argvlen.push_back(d.size()); }
+
+    if (redisAppendCommand(m_ctx, "PING") != REDIS_OK) { freeContext(); return false; }
+    if (redisAppendCommandArgv(m_ctx, (int)argv.size(), argv.data(), argvlen.data()) != REDIS_OK) { freeContext(); return false; }
+    QtReplyPtr reply;
+    bool pingOk = false;
+    {
+        QtReaderScope qt(m_ctx);
+        QtReplyPtr ping = qtGetReply(m_ctx);
+        if (!ping) { freeContext(); return false; }
+        pingOk = (ping->type == REDIS_REPLY_STATUS || ping->type == REDIS_REPLY_STRING);
+        reply = qtGetReply(m_ctx);
+        if (!reply) { freeContext(); return false; }
+    }
+    if (reply->type == REDIS_REPLY_ERROR && reply->str.startsWith("NOSCRIPT")) {
+        // Script-Cache geleert (Restart / SCRIPT FLUSH): neu laden und einmal wiederholen
+        if (!loadDigestScript()) return false;
+        argv[1] = m_digestSha.data(); argvlen[1] = m_digestSha.size();
+        if (redisAppendCommandArgv(m_ctx, (int)argv.size(), argv.data(), argvlen.data()) != REDIS_OK) { freeContext(); return false; }
+        QtReaderScope qt(m_ctx);
+        reply = qtGetReply(m_ctx);
+        if (!reply) { freeContext(); return false; }
+    }
+    if (reply->type != REDIS_REPLY_ARRAY || reply->element.size() != 2 * keys.size()) {
+        std::cerr << "Redis digest script error: " << (reply->type == REDIS_REPLY_ERROR ? reply->str.constData() : "unexpected reply") << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        QtReply* d = reply->element[2 * i];
+        QtReply* v = reply->element[2 * i + 1];
+        std::string digest = (d->type == REDIS_REPLY_STRING) ? d->str.toStdString() : std::string();
+        if (v->type == REDIS_REPLY_STRING) {
+            values[i] = std::move(v->str);
+            changed[i] = true;
+        } else if (digest.empty() && !digests[i].empty()) {
+            changed[i] = true; // Key gelöscht
+        }
+        digests[i] = std::move(digest);
+    }
+    return pingOk;
+#endif
+}
@@ -1,7 +1,10 @@
 #pragma once
+#include <QByteArray>
+#include <cstdint>
 #include <string>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -20,8 +23,77 @@ public:
     void setPort(int p) { if (p != m_port) { freeContext(); m_port = p; } }
     void setPassword(const std::string& pw) { if (pw != m_password) { freeContext(); m_password = pw; } }
 
-    // Returns raw string value (nullptr if not found / error)
-    std::optional<std::string> get(const std::string& key);
+    // Host "unix:/pfad/redis.sock" verbindet per Unix Domain Socket (Port wird dann ignoriert)
+    bool isUnixSocket() const { return m_host.rfind("unix:", 0) == 0; }
+    // Socket Optionen für TCP Verbindungen (bei Unix Sockets ohne Wirkung), gelten ab dem nächsten Connect
+    struct SocketOptions {
+        bool tcpNoDelay = true;   // hiredis setzt TCP_NODELAY selbst, false schaltet Nagle wieder ein
+        int keepAliveSec = 0;     // 0 = kein TCP Keepalive, sonst Intervall in Sekunden
+        int recvBufferBytes = 0;  // SO_RCVBUF, 0 = Betriebssystem Default
+    };
+    void setSocketOptions(const SocketOptions& opts) { freeContext(); m_socketOptions = opts; if (m_master) m_master->setSocketOptions(opts); }
+    // Connect- und Kommando-Timeout (0 = blockierend wie bisher), gilt ab dem nächsten Connect
+    void setTimeoutMs(int ms) { if (ms != m_timeoutMs) { freeContext(); m_timeoutMs = ms; } }
+    int timeoutMs() const { return m_timeoutMs; }
+    const SocketOptions& socketOptions() const { return m_socketOptions; }
+
+    // Replikations-Routing: zweite Verbindung zum Master (leerer Host = aus). Lesezugriffe gehen an die Replica
+    // (dieser Client), solange probeReplication() sie für frisch hält, sonst an den Master.
+    void setMasterEndpoint(const std::string& host, int port, const std::string& password);
+    // Replica gilt als veraltet bei master_link_status:down, master_last_io_seconds_ago > maxSeconds oder
+    // Offset-Differenz zum Master > maxBytes (0 = Bytes nicht prüfen). Master pingt Replicas alle 10s (Redis Default).
+    void setMaxReplicationLag(int maxSeconds, long long maxBytes) { m_maxLagSeconds = maxSeconds; m_maxLagBytes = maxBytes; }
+    struct ReplicationStatus {
+        bool replicaUp = false;    // Replica erreichbar
+        bool linkUp = false;       // master_link_status:up
+        int lastIoSeconds = -1;    // master_last_io_seconds_ago (-1 = unbekannt)
+        long long lagBytes = -1;   // master_repl_offset (Master) - slave_repl_offset (Replica), -1 = unbekannt
+        bool usingMaster = false;  // aktuelle Lesequelle
+        bool stale = false;        // Replica veraltet, Master aber nicht erreichbar: Reads laufen trotzdem über die Replica
+    };
+    // INFO replication auf Replica (und mit --max-lag-bytes auf dem Master für den Offset), aktualisiert die Lesequelle.
+    // false = keine Quelle erreichbar
+    bool probeReplication();
+    bool hasMaster() const { return m_master != nullptr; }
+    ReplicationStatus replicationStatus() const { return m_replication; }
+
+    // Returns raw value (nullopt if not found / error). Werte kommen ohne Umweg über redisReply/std::string
+    // direkt aus dem hiredis Read-Buffer (eigene redisReplyObjectFunctions) und sind implizit geteilt.
+    std::optional<QByteArray> get(const std::string& key);
+
+    // Pipeline: PING + GET für alle Keys in einem Write, alle Replies in einem Durchgang (1 RTT).
+    // Rückgabe false wenn Verbindung oder PING fehlschlägt; values[i] bleibt nullopt bei nil/Fehler.
+    bool pipelineGet(const std::vector<std::string>& keys, std::vector<std::optional<QByteArray>>& values);
+
+    // ZRANGEBYSCORE key min max WITHSCORES (min/max in Redis Syntax, z.B. "-inf", "(123", "+inf")
+    bool zrangeByScore(const std::string& key, const std::string& min, const std::string& max,
+                       std::vector<std::pair<std::string, double>>& members);
+    // HMGET für viele Keys in einem Round-Trip; values[i][j] = fields[j] von keys[i] (nullopt = fehlt)
+    bool pipelineHmget(const std::vector<std::string>& keys, const std::vector<std::string>& fields,
+                       std::vector<std::vector<std::optional<QByteArray>>>& values);
+
+    // Conditional Fetch per Lua (SCRIPT LOAD einmalig, dann EVALSHA): der Server vergleicht SHA1 des aktuellen Werts
+    // mit digests[i] und schickt den Wert nur bei Abweichung. PING + alle Keys in einem Round-Trip.
+    // changed[i] = Wert neu oder Key verschwunden (values[i] dann gesetzt bzw. nullopt); digests wird aktualisiert
+    // ("" = Key fehlt). Rückgabe false bei Verbindungs-/Script-Fehler.
+    bool pipelineGetIfChanged(const std::vector<std::string>& keys, std::vector<std::string>& digests,
+                              std::vector<std::optional<QByteArray>>& values, std::vector<bool>& changed);
+
+    // Client-side Caching (RESP3 HELLO 3 + CLIENT TRACKING ON, Redis >= 6). Wirkt ab dem nächsten Connect.
+    // Gelesene Werte bleiben lokal bis der Server eine "invalidate" Push-Nachricht schickt. Pushes werden nur
+    // beim Lesen vom Socket verarbeitet -> der Cache ist so aktuell wie der letzte Round-Trip (ping()/pipelineGet()).
+    void setClientTracking(bool enabled) {
+        if (m_master) m_master->setClientTracking(enabled);
+        if (enabled != m_trackingWanted) { freeContext(); m_trackingWanted = enabled; }
+    }
+    bool isTrackingActive() const { return m_trackingActive; }
+    struct CacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;
+        size_t entries = 0;
+    };
+    CacheStats cacheStats() const { CacheStats s = m_stats; s.entries = m_cache.size(); return s; }
 
 private:
     std::string m_host;
@@ -29,7 +101,25 @@ private:
     int m_db;
     std::string m_password;
     redisContext* m_ctx {nullptr};
+    bool m_trackingWanted {false};
+    bool m_trackingActive {false};
+    std::unordered_map<std::string, std::optional<QByteArray>> m_cache; // nullopt = Key existiert nicht
+    CacheStats m_stats;
+    std::string m_digestSha; // SHA des geladenen Digest-Scripts
+    SocketOptions m_socketOptions;
+    int m_timeoutMs {0};
+    std::unique_ptr<RedisClient> m_master;
+    int m_maxLagSeconds {15};
+    long long m_maxLagBytes {0};
+    ReplicationStatus m_replication;
 
     void freeContext();
     bool authIfNeeded();
+    bool applySocketOptions();
+    bool readFromMaster() const { return m_master && m_replication.usingMaster; }
+    // INFO <section> als Text (nullopt bei Verbindungsfehler)
+    std::optional<std::string> info(const char* section);
+    bool enableTracking();
+    bool loadDigestScript();
+    static void onPush(void* privdata, void* reply);
 };
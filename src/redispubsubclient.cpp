@@ -0,0 +1,86 @@
+// Redis Pub/Sub Subscriber (market_data:updated, chart_data:<SYM>:updated, predictions:<SYM>:updated)
+#include "redispubsubclient.h"
+#include "marketmodel.h"
+#include "chartdatamodel.h"
+#include "predictionsmodel.h"
+#include "valuecodec.h"
+#include <QByteArray>
+#include <QDebug>
+
+static const char* kMarketChannel = "market_data:updated";
+
+RedisPubSubClient::RedisPubSubClient(const QString& host, int port, const QString& password, QObject* parent)
+    : QObject(parent), m_client(host.toStdString(), port, 0, password.toStdString()) {
+    m_staleTimer.setSingleShot(true);
+    m_staleTimer.setInterval(15000);
+    connect(&m_staleTimer, &QTimer::timeout, this, [this]() { setHealthy(false); });
+    connect(&m_client, &RedisAsyncClient::connected, this, [this]() {
+        // Subscriptions erneuert RedisAsyncClient selbst; gesund erst mit der ersten Nachricht
+        if (m_everConnected) emit reconnected();
+        m_everConnected = true;
+    });
+    connect(&m_client, &RedisAsyncClient::disconnected, this, [this]() {
+        m_staleTimer.stop();
+        setHealthy(false);
+        emit connectionLost();
+    });
+    connect(&m_client, &RedisAsyncClient::errorOccurred, this, [](const QString& msg) {
+        qWarning() << "pubsub redis:" << msg;
+    });
+
+    auto onMessage = [this](const std::string& channel, const std::string& payload) { deliver(channel, payload); };
+    m_client.subscribe({kMarketChannel}, onMessage);
+}
+
+void RedisPubSubClient::start() {
+    m_client.connectToServer();
+}
+
+void RedisPubSubClient::stop() {
+    m_client.disconnectFromServer();
+    m_staleTimer.stop();
+    setHealthy(false);
+}
+
+std::vector<std::string> RedisPubSubClient::symbolChannels(const QString& sym) const {
+    std::vector<std::string> channels;
+    if (sym.isEmpty()) return channels;
+    if (m_chartModel) channels.push_back(chartChannel(sym));
+    if (m_predictionsModel) channels.push_back(predictionsChannel(sym));
+    return channels;
+}
+
+void RedisPubSubClient::setCurrentSymbol(const QString& sym) {
+    if (sym == m_currentSymbol) return;
+    const auto oldChannels = symbolChannels(m_currentSymbol);
+    if (!oldChannels.empty()) m_client.unsubscribe(oldChannels);
+    m_currentSymbol = sym;
+    const auto newChannels = symbolChannels(m_currentSymbol);
+    if (!newChannels.empty()) {
+        m_client.subscribe(newChannels, [this](const std::string& channel, const std::string& payload) { deliver(channel, payload); });
+    }
+    emit currentSymbolChanged(m_currentSymbol);
+}
+
+void RedisPubSubClient::deliver(const std::string& channel, const std::string& payload) {
+    ++m_messageCount;
+    m_staleTimer.start();
+    setHealthy(true);
+    if (payload.empty()) return;
+    QByteArray bytes;
+    if (!ValueCodec::decode(QByteArray::fromStdString(payload), bytes)) {
+        qWarning() << "pubsub: corrupt compressed payload on" << QString::fromStdString(channel);
+        return;
+    }
+    if (channel == kMarketChannel) {
+        if (m_marketModel) m_marketModel->updateFromJson(bytes);
+    } else if (channel == chartChannel(m_currentSymbol)) {
+        // Nachrichten für ein altes Symbol (UNSUBSCRIBE noch unterwegs) fallen hier raus
+        if (m_chartModel) m_chartModel->updateFromJson(bytes);
+    } else if (channel == predictionsChannel(m_currentSymbol)) {
+        if (m_predictionsModel) m_predictionsModel->updateFromJson(bytes);
+    } else {
+        return;
+    }
+    emit dataReceived(QString::fromStdString(channel), bytes);
+}
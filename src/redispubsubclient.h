@@ -0,0 +1,64 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <string>
+#include <vector>
+#include "redisasyncclient.h"
+
+class MarketModel;
+class ChartDataModel;
+class PredictionsModel;
+
+// Echtzeit-Updates per Redis Pub/Sub (siehe pubsub.txt).
+// Eigene Verbindung (im Subscribe-Modus sind keine normalen Kommandos erlaubt), Payload = Key-Wert,
+// wird direkt in die Models geschrieben. Polling bleibt als Fallback im DataPoller.
+class RedisPubSubClient : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool healthy READ isHealthy NOTIFY healthChanged)
+    Q_PROPERTY(QString currentSymbol READ currentSymbol WRITE setCurrentSymbol NOTIFY currentSymbolChanged)
+public:
+    explicit RedisPubSubClient(const QString& host = "127.0.0.1", int port = 6380, const QString& password = QString(),
+                               QObject* parent = nullptr);
+
+    void setMarketModel(MarketModel* m) { m_marketModel = m; }
+    void setChartModel(ChartDataModel* m) { m_chartModel = m; }
+    void setPredictionsModel(PredictionsModel* m) { m_predictionsModel = m; }
+    // Ohne Nachricht innerhalb dieser Zeit gilt der Push-Kanal als ungesund (Backend publisht evtl. nicht)
+    void setStaleAfterMs(int ms) { m_staleTimer.setInterval(ms); }
+
+    // verbunden und zuletzt Nachrichten empfangen
+    bool isHealthy() const { return m_healthy; }
+    QString currentSymbol() const { return m_currentSymbol; }
+    qint64 messageCount() const { return m_messageCount; }
+
+public slots:
+    void start();
+    void stop();
+    // UNSUBSCRIBE alte / SUBSCRIBE neue Symbol-Kanäle
+    void setCurrentSymbol(const QString& sym);
+
+signals:
+    void healthChanged(bool healthy);
+    void currentSymbolChanged(const QString& s);
+    void dataReceived(const QString& channel, const QByteArray& payload);
+    void connectionLost();
+    void reconnected();
+
+private:
+    RedisAsyncClient m_client;
+    MarketModel* m_marketModel {nullptr};
+    ChartDataModel* m_chartModel {nullptr};
+    PredictionsModel* m_predictionsModel {nullptr};
+    QString m_currentSymbol;
+    QTimer m_staleTimer;
+    bool m_healthy {false};
+    bool m_everConnected {false};
+    qint64 m_messageCount {0};
+
+    static std::string chartChannel(const QString& sym) { return "chart_data:" + sym.toStdString() + ":updated"; }
+    static std::string predictionsChannel(const QString& sym) { return "predictions:" + sym.toStdString() + ":updated"; }
+    std::vector<std::string> symbolChannels(const QString& sym) const;
+    void deliver(const std::string& channel, const std::string& payload);
+    void setHealthy(bool h) { if (h != m_healthy) { m_healthy = h; emit healthChanged(m_healthy); } }
+};
@@ -0,0 +1,117 @@
+// Batched async Write Queue (SET/HSET, eine Pipeline pro Event-Loop Tick)
+#include "rediswritequeue.h"
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+#ifndef REDIS_STUB
+#if defined(HIREDIS_VENDORED)
+#include <hiredis.h>
+#else
+#include <hiredis/hiredis.h>
+#endif
+#endif
+
+RedisWriteQueue::RedisWriteQueue(const QString& host, int port, const QString& password, QObject* parent)
+    : QObject(parent), m_client(host.toStdString(), port, 0, password.toStdString()) {
+    // Nach (Re)Connect liegengebliebene Writes senden
+    connect(&m_client, &RedisAsyncClient::connected, this, &RedisWriteQueue::scheduleFlush);
+    connect(&m_client, &RedisAsyncClient::errorOccurred, this, [](const QString& msg) {
+        qWarning() << "write queue redis:" << msg;
+    });
+}
+
+RedisWriteQueue::~RedisWriteQueue() {
+    // Verbindung abbauen solange m_queue noch lebt (m_client ist vor m_queue deklariert und würde sonst zuletzt zerstört)
+    m_tearingDown = true;
+    m_client.disconnectFromServer();
+}
+
+void RedisWriteQueue::start() {
+    m_client.connectToServer();
+}
+
+void RedisWriteQueue::stop() {
+    m_client.disconnectFromServer();
+}
+
+quint64 RedisWriteQueue::set(const std::string& key, const QByteArray& value, ResultCallback cb) {
+    return enqueue({ "SET", key, value.toStdString() }, std::move(cb));
+}
+
+quint64 RedisWriteQueue::hset(const std::string& key, const std::vector<std::pair<std::string, QByteArray>>& fields, ResultCallback cb) {
+    std::vector<std::string> args { "HSET", key };
+    args.reserve(2 + fields.size() * 2);
+    for (const auto& f : fields) {
+        args.push_back(f.first);
+        args.push_back(f.second.toStdString());
+    }
+    return enqueue(std::move(args), std::move(cb));
+}
+
+quint64 RedisWriteQueue::setAlpacaMode(const QString& mode) {
+    if (mode != "live" && mode != "paper") {
+        const quint64 id = m_nextId++;
+        // asynchron melden wie jeder andere Request (Aufrufer verbindet sich evtl. erst nach dem Aufruf)
+        QTimer::singleShot(0, this, [this, id, mode]() { emit writeFinished(id, false, "invalid alpaca_mode: " + mode); });
+        return id;
+    }
+    return set("alpaca_mode", mode.toUtf8());
+}
+
+quint64 RedisWriteQueue::setSchedule(const QString& which, const QVariantMap& schedule) {
+    const QByteArray json = QJsonDocument(QJsonObject::fromVariantMap(schedule)).toJson(QJsonDocument::Compact);
+    return set((which == "ml" ? "ml_schedule" : "grok_schedule"), json);
+}
+
+quint64 RedisWriteQueue::enqueue(std::vector<std::string> args, ResultCallback cb) {
+    if (static_cast<int>(m_queue.size()) >= kMaxQueued) {
+        // ältesten Write verwerfen statt unbegrenzt zu wachsen (Verbindung dauerhaft weg)
+        Request dropped = std::move(m_queue.front());
+        m_queue.pop_front();
+        complete(dropped, false, QStringLiteral("write queue full, dropped"));
+    }
+    const quint64 id = m_nextId++;
+    m_queue.push_back(Request { id, std::move(args), std::move(cb) });
+    emit pendingChanged(pending());
+    scheduleFlush();
+    return id;
+}
+
+void RedisWriteQueue::scheduleFlush() {
+    if (m_flushScheduled) return;
+    m_flushScheduled = true;
+    // nächster Event-Loop Tick: alles bis dahin Eingereihte landet in derselben Pipeline
+    QTimer::singleShot(0, this, &RedisWriteQueue::flush);
+}
+
+void RedisWriteQueue::flush() {
+    m_flushScheduled = false;
+    if (m_queue.empty() || !m_client.isConnected()) return;
+    // hiredis puffert alle Kommandos und schreibt sie gesammelt sobald der Socket schreibbar ist (ein Write)
+    while (!m_queue.empty()) {
+        auto req = std::make_shared<Request>(std::move(m_queue.front()));
+        m_queue.pop_front();
+        ++m_inFlight;
+        m_client.command(req->args, [this, req](redisReply* reply) {
+            if (m_tearingDown) return;
+            --m_inFlight;
+#ifndef REDIS_STUB
+            if (!reply) complete(*req, false, QStringLiteral("connection lost"));
+            else if (reply->type == REDIS_REPLY_ERROR) complete(*req, false, QString::fromUtf8(reply->str, static_cast<int>(reply->len)));
+            else complete(*req, true, QString());
+#else
+            Q_UNUSED(reply);
+            complete(*req, false, QStringLiteral("Redis stub mode"));
+#endif
+        });
+    }
+}
+
+void RedisWriteQueue::complete(const Request& req, bool ok, const QString& error) {
+    if (!ok) qWarning() << "redis write" << QString::fromStdString(req.args[0]) << QString::fromStdString(req.args[1]) << "failed:" << error;
+    if (req.cb) req.cb(ok, error);
+    emit writeFinished(req.id, ok, error);
+    emit pendingChanged(pending());
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "redisasyncclient.h"
+
+// Nicht-blockierende Schreib-Queue für die vom Frontend beschreibbaren Keys (redis.txt 7, 12, 13).
+// set()/hset() kehren sofort zurück; alle bis zum nächsten Event-Loop Tick gesammelten Kommandos gehen als eine
+// Pipeline über eine eigene async Verbindung raus. Ergebnis je Request per Callback und writeFinished(id, ...).
+// Ohne Verbindung bleiben Writes (max. kMaxQueued) liegen und werden nach dem Connect gesendet.
+// Ziel muss schreibbar sein: die lokale Replica ist read-only -> in main mit dem Master verbinden, falls gesetzt.
+class RedisWriteQueue : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int pending READ pending NOTIFY pendingChanged)
+public:
+    using ResultCallback = std::function<void(bool ok, const QString& error)>;
+    static constexpr int kMaxQueued = 256;
+
+    explicit RedisWriteQueue(const QString& host = "127.0.0.1", int port = 6380, const QString& password = QString(),
+                             QObject* parent = nullptr);
+    ~RedisWriteQueue() override;
+
+    // Rückgabe: Request-Id (auch in writeFinished), nie 0
+    quint64 set(const std::string& key, const QByteArray& value, ResultCallback cb = {});
+    quint64 hset(const std::string& key, const std::vector<std::pair<std::string, QByteArray>>& fields, ResultCallback cb = {});
+    int pending() const { return static_cast<int>(m_queue.size() + m_inFlight); }
+
+    // QML Einstiege für die Schema-Keys
+    Q_INVOKABLE quint64 triggerGrok() { return set("manual_trigger_grok", "true"); }
+    Q_INVOKABLE quint64 triggerMl() { return set("manual_trigger_ml", "true"); }
+    Q_INVOKABLE quint64 setAlpacaMode(const QString& mode); // "live" | "paper"
+    // which = "grok" | "ml"; schedule wird als JSON Objekt geschrieben (Felder siehe redis.txt 13)
+    Q_INVOKABLE quint64 setSchedule(const QString& which, const QVariantMap& schedule);
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void writeFinished(quint64 id, bool ok, const QString& error);
+    void pendingChanged(int pending);
+
+private:
+    struct Request {
+        quint64 id;
+        std::vector<std::string> args;
+        ResultCallback cb;
+    };
+    RedisAsyncClient m_client;
+    std::deque<Request> m_queue;
+    int m_inFlight {0};
+    quint64 m_nextId {1};
+    bool m_flushScheduled {false};
+    // im Destruktor gesetzt: redisAsyncFree ruft offene Callbacks mit nullptr, die dürfen dann weder
+    // m_queue lesen noch Nutzer-Callbacks/Signale auslösen
+    bool m_tearingDown {false};
+
+    quint64 enqueue(std::vector<std::string> args, ResultCallback cb);
+    void scheduleFlush();
+    void flush();
+    void complete(const Request& req, bool ok, const QString& error);
+};
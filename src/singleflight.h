@@ -0,0 +1,67 @@
+#pragma once
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Single-Flight: gleichzeitige Aufrufe mit demselben Key teilen sich eine Ausführung.
+// Der erste Aufrufer (Leader) führt fn aus, alle weiteren warten auf dessen Ergebnis.
+// Nach Abschluss wird der Key freigegeben, der nächste Aufruf startet eine neue Ausführung.
+// Ruft fn selbst wieder run() mit demselben Key auf (gleicher Thread), läuft der innere Aufruf direkt
+// statt auf das eigene, noch offene Ergebnis zu warten (Deadlock).
+template <typename T>
+class SingleFlight {
+public:
+    struct Result {
+        T value;
+        bool shared;  // true = Ergebnis eines fremden Flugs übernommen
+    };
+
+    Result run(const std::string& key, const std::function<T()>& fn) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = m_inFlight.find(key);
+        if (it != m_inFlight.end()) {
+            if (it->second.owner == std::this_thread::get_id()) {
+                lock.unlock();
+                return { fn(), false };
+            }
+            std::shared_future<T> pending = it->second.result;
+            lock.unlock();
+            return { pending.get(), true };
+        }
+        std::promise<T> promise;
+        m_inFlight.emplace(key, Flight { promise.get_future().share(), std::this_thread::get_id() });
+        lock.unlock();
+
+        // Key auch bei Exception freigeben, Wartende bekommen die Exception weitergereicht
+        struct Release {
+            SingleFlight* self;
+            const std::string& key;
+            ~Release() { std::lock_guard<std::mutex> g(self->m_mutex); self->m_inFlight.erase(key); }
+        } release { this, key };
+        try {
+            T value = fn();
+            promise.set_value(value);
+            return { std::move(value), false };
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    bool isInFlight(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_inFlight.count(key) > 0;
+    }
+
+private:
+    struct Flight {
+        std::shared_future<T> result;
+        std::thread::id owner; // Thread des Leaders
+    };
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Flight> m_inFlight;
+};
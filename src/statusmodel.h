@@ -3,6 +3,8 @@
 #include <QString>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include "cborreader.h"
+#include "lenientjson.h"
 
 class StatusModel : public QObject {
     Q_OBJECT
@@ -12,6 +14,14 @@ class StatusModel : public QObject {
     Q_PROPERTY(bool grokApiActive READ grokApiActive NOTIFY statusChanged)
     Q_PROPERTY(bool workerRunning READ workerRunning NOTIFY statusChanged)
     Q_PROPERTY(QString lastHeartbeat READ lastHeartbeat NOTIFY statusChanged)
+    // Replikations-Routing (nur mit --master-host): Lesequelle "replica"/"master", Lag der lokalen Replica
+    Q_PROPERTY(bool replicationRouted READ replicationRouted NOTIFY statusChanged)
+    Q_PROPERTY(QString readSource READ readSource NOTIFY statusChanged)
+    Q_PROPERTY(bool replicaLinkUp READ replicaLinkUp NOTIFY statusChanged)
+    Q_PROPERTY(int replicationLagSeconds READ replicationLagSeconds NOTIFY statusChanged)
+    Q_PROPERTY(qint64 replicationLagBytes READ replicationLagBytes NOTIFY statusChanged)
+    // Replica veraltet und Master nicht erreichbar: angezeigte Daten kommen trotzdem von der Replica
+    Q_PROPERTY(bool replicationStale READ replicationStale NOTIFY statusChanged)
 public:
     explicit StatusModel(QObject* parent=nullptr): QObject(parent) {}
 
@@ -21,9 +31,16 @@ public:
     bool grokApiActive() const { return m_grokApiActive; }
     bool workerRunning() const { return m_workerRunning; }
     QString lastHeartbeat() const { return m_lastHeartbeat; }
+    bool replicationRouted() const { return m_replicationRouted; }
+    QString readSource() const { return m_readSource; }
+    bool replicaLinkUp() const { return m_replicaLinkUp; }
+    int replicationLagSeconds() const { return m_replicationLagSeconds; }
+    qint64 replicationLagBytes() const { return m_replicationLagBytes; }
+    bool replicationStale() const { return m_replicationStale; }
 
     void updateFromJson(const QByteArray& jsonBytes) {
-        QJsonParseError err{}; auto doc=QJsonDocument::fromJson(jsonBytes,&err); if(err.error!=QJsonParseError::NoError||!doc.isObject()) return; auto o=doc.object();
+        if (CborReader::isCbor(jsonBytes)) { updateFromCbor(jsonBytes); return; }
+        QJsonParseError err{}; auto doc=LenientJson::parse(jsonBytes, &err); if(err.error!=QJsonParseError::NoError||!doc.isObject()) return; auto o=doc.object();
         bool changed=false;
         auto upd=[&](bool &field,bool val){ if(field!=val){ field=val; changed=true; }};
         upd(m_redisConnected, o.value("redis_connected").toBool());
@@ -32,6 +49,36 @@ public:
         upd(m_grokApiActive, o.value("grok_api_active").toBool());
         upd(m_workerRunning, o.value("worker_running").toBool());
         QString hb = o.value("last_heartbeat").toString(); if (m_lastHeartbeat!=hb){ m_lastHeartbeat=hb; changed=true; }
+        updReplication(changed, o.value("read_source").toString(), o.value("replica_link_up").toBool(true),
+                       o.value("replication_last_io_s").toInt(-1), qint64(o.value("replication_lag_bytes").toDouble(-1)),
+                       o.value("replication_stale").toBool());
+        if(changed) emit statusChanged();
+    }
+    void updateFromCbor(const QByteArray& cborBytes) {
+        // fehlende Felder zählen wie im JSON Pfad als false / leer
+        CborReader r(cborBytes); bool redis=false, postgres=false, alpaca=false, grok=false, worker=false; QString hb;
+        QString source; bool linkUp=true; int lagS=-1; qint64 lagBytes=-1; bool stale=false;
+        const bool ok = r.readMap([&](const QString& key){
+            if(key==QLatin1String("redis_connected")) redis=r.readBool();
+            else if(key==QLatin1String("postgres_connected")) postgres=r.readBool();
+            else if(key==QLatin1String("alpaca_api_active")) alpaca=r.readBool();
+            else if(key==QLatin1String("grok_api_active")) grok=r.readBool();
+            else if(key==QLatin1String("worker_running")) worker=r.readBool();
+            else if(key==QLatin1String("last_heartbeat")) hb=r.readString();
+            else if(key==QLatin1String("read_source")) source=r.readString();
+            else if(key==QLatin1String("replica_link_up")) linkUp=r.readBool();
+            else if(key==QLatin1String("replication_last_io_s")) lagS=int(r.readInteger());
+            else if(key==QLatin1String("replication_lag_bytes")) lagBytes=r.readInteger();
+            else if(key==QLatin1String("replication_stale")) stale=r.readBool();
+            else r.skip();
+        });
+        if(!ok) return;
+        bool changed=false;
+        auto upd=[&](bool &field,bool val){ if(field!=val){ field=val; changed=true; }};
+        upd(m_redisConnected, redis); upd(m_postgresConnected, postgres); upd(m_alpacaApiActive, alpaca);
+        upd(m_grokApiActive, grok); upd(m_workerRunning, worker);
+        if (m_lastHeartbeat!=hb){ m_lastHeartbeat=hb; changed=true; }
+        updReplication(changed, source, linkUp, lagS, lagBytes, stale);
         if(changed) emit statusChanged();
     }
 signals:
@@ -43,4 +90,21 @@ private:
     bool m_grokApiActive=false;
     bool m_workerRunning=false;
     QString m_lastHeartbeat;
+    bool m_replicationRouted=false; // Status enthält read_source (Routing konfiguriert)
+    QString m_readSource {"replica"};
+    bool m_replicaLinkUp=true;
+    int m_replicationLagSeconds=-1;
+    qint64 m_replicationLagBytes=-1;
+    bool m_replicationStale=false;
+
+    void updReplication(bool& changed, const QString& source, bool linkUp, int lagS, qint64 lagBytes, bool stale) {
+        const bool routed = !source.isEmpty();
+        if (m_replicationRouted!=routed){ m_replicationRouted=routed; changed=true; }
+        const QString src = routed ? source : QStringLiteral("replica");
+        if (m_readSource!=src){ m_readSource=src; changed=true; }
+        if (m_replicaLinkUp!=linkUp){ m_replicaLinkUp=linkUp; changed=true; }
+        if (m_replicationLagSeconds!=lagS){ m_replicationLagSeconds=lagS; changed=true; }
+        if (m_replicationLagBytes!=lagBytes){ m_replicationLagBytes=lagBytes; changed=true; }
+        if (m_replicationStale!=stale){ m_replicationStale=stale; changed=true; }
+    }
 };
@@ -0,0 +1,23 @@
+// Komprimierte Redis Values (siehe valuecodec.h)
+#include "valuecodec.h"
+
+namespace {
+constexpr char kMagic[] = "\x1FQZ1";
+constexpr qsizetype kMagicSize = 4;
+constexpr qsizetype kSizeHeader = 4; // qCompress: erwartete Originalgröße, Big-Endian
+}
+
+bool ValueCodec::isCompressed(const QByteArray& raw) {
+    return raw.size() >= kMagicSize + kSizeHeader && raw.startsWith(QByteArray::fromRawData(kMagic, kMagicSize));
+}
+
+bool ValueCodec::decode(const QByteArray& raw, QByteArray& out) {
+    if (!isCompressed(raw)) { out = raw; return true; }
+    const auto* payload = reinterpret_cast<const uchar*>(raw.constData() + kMagicSize);
+    const qsizetype payloadSize = raw.size() - kMagicSize;
+    // Originalgröße 0: qUncompress liefert auch dann ein leeres Array, das ist kein Fehler
+    const bool emptyValue = payload[0] == 0 && payload[1] == 0 && payload[2] == 0 && payload[3] == 0;
+    // qUncompress alloziert anhand des Größen-Headers genau einmal (kein Wachsen beim Inflaten)
+    out = qUncompress(payload, payloadSize);
+    return !out.isEmpty() || emptyValue;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <QByteArray>
+
+// Optionales komprimiertes Format für große Redis Values (chart_data_<SYM>, grok_deepersearch, ml_training_log, ...).
+// Frame: Magic "\x1FQZ1" + qCompress Format (4 Byte Big-Endian Originalgröße + zlib Stream).
+// Backend (Python): b"\x1fQZ1" + struct.pack(">I", len(raw)) + zlib.compress(raw)
+// 0x1F kann weder JSON noch (wohlgeformtes) CBOR einleiten -> Werte ohne Magic gehen unverändert durch.
+class ValueCodec {
+public:
+    static bool isCompressed(const QByteArray& raw);
+    // Plain Values: out = raw (implizit geteilt, keine Kopie). Komprimiert: out = entpackter Wert.
+    // false bei kaputtem Frame (out bleibt dann leer).
+    static bool decode(const QByteArray& raw, QByteArray& out);
+};